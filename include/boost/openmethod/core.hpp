@@ -8,10 +8,15 @@
 
 #include <stdint.h>
 #include <algorithm>
+#include <atomic>
+#include <climits>
 #include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <variant>
 
 #include <boost/assert.hpp>
 #include <boost/config.hpp>
@@ -67,6 +72,18 @@ namespace detail {
 
 using macro_default_registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY;
 
+// BOOST_OPENMETHOD_OVERRIDE also specializes the overrider template for the
+// overrider's parameters, preceded by `overrider_key`, so static registries
+// can find the overriders of a method without knowing their return types.
+struct overrider_key;
+
+// Binds the overrider template of a method declared with BOOST_OPENMETHOD.
+template<template<typename> class Overriders>
+struct macro_overriders {
+    template<typename Key>
+    using fn = Overriders<Key>;
+};
+
 template<typename...>
 struct extract_registry;
 
@@ -103,16 +120,80 @@ struct init_type_ids<Registry, mp11::mp_list<Class...>> {
     }
 };
 
+template<typename T>
+struct is_variant_aux : std::false_type {};
+
+template<typename... Types>
+struct is_variant_aux<std::variant<Types...>> : std::true_type {};
+
+template<typename T>
+constexpr bool is_variant = is_variant_aux<T>::value;
+
+// Like std::is_base_of, but also treats the alternatives of a std::variant as
+// its subclasses.
+template<class Base, class Derived>
+struct is_base_or_alternative : std::is_base_of<Base, Derived> {};
+
+template<class... Types, class Derived>
+struct is_base_or_alternative<std::variant<Types...>, Derived>
+    : std::bool_constant<
+          std::is_same_v<std::variant<Types...>, Derived> ||
+          (std::is_same_v<Types, Derived> || ...)> {};
+
+// Returns the type_id of the alternative held by a variant.
+template<class Rtti, class... Types>
+auto variant_type(const std::variant<Types...>& arg) -> type_id {
+    BOOST_ASSERT(!arg.valueless_by_exception());
+    type_id types[] = {Rtti::template static_type<Types>()...};
+
+    return types[arg.index()];
+}
+
+// The addresses of the static vptrs of the alternatives of a variant, indexed
+// by the variant's index.
+template<class Registry, class Variant>
+struct variant_vptrs;
+
+template<class Registry, class... Types>
+struct variant_vptrs<Registry, std::variant<Types...>> {
+    static constexpr const vptr_type* value[] = {
+        &Registry::template static_vptr<Types>...};
+};
+
+// The addresses of the class indexes of the alternatives of a variant, indexed
+// by the variant's index.
+template<class Registry, class Variant>
+struct variant_vindexes;
+
+template<class Registry, class... Types>
+struct variant_vindexes<Registry, std::variant<Types...>> {
+    static constexpr const vindex_type* value[] = {
+        &Registry::template static_vindex<Types>...};
+};
+
+// Returns a variant's alternative, or the variant itself.
+template<typename Derived, class Variant>
+auto variant_cast(Variant& obj) -> Derived {
+    using Class = std::remove_cv_t<std::remove_reference_t<Derived>>;
+
+    if constexpr (std::is_same_v<Class, std::remove_cv_t<Variant>>) {
+        return obj;
+    } else {
+        return *std::get_if<Class>(&obj);
+    }
+}
+
 // Collect the base classes of a list of classes. The result is a mp11 map that
 // associates each class to a list starting with the class itself, followed by
-// all its bases, as per std::is_base_of. Thus the list includes the class
-// itself at least twice: at the front, and down the list, as its own improper
-// base. The direct and indirect bases are all included. The runtime will
-// extract the direct proper bases.
+// all its bases, as per is_base_or_alternative. Thus the list includes the
+// class itself at least twice: at the front, and down the list, as its own
+// improper base. The direct and indirect bases are all included. The runtime
+// will extract the direct proper bases.
 template<typename... Cs>
 using inheritance_map = mp11::mp_list<boost::mp11::mp_push_front<
     boost::mp11::mp_filter_q<
-        boost::mp11::mp_bind_back<std::is_base_of, Cs>, mp11::mp_list<Cs...>>,
+        boost::mp11::mp_bind_back<is_base_or_alternative, Cs>,
+        mp11::mp_list<Cs...>>,
     Cs>...>;
 
 // =============================================================================
@@ -322,6 +403,73 @@ struct virtual_traits<Class*, Registry> {
     }
 };
 
+//! Specialize virtual_traits for references to `std::variant`.
+//!
+//! The alternatives of a variant are treated as its subclasses. They must be
+//! registered, together with the variant, in the same call to @ref
+//! use_classes or @ref BOOST_OPENMETHOD_CLASSES. The overriders take the
+//! alternatives directly, or the variant itself as a fallback.
+//!
+//! The v-table pointer of an argument is obtained from its `index()`, via a
+//! table of pointers to the static v-table pointers of the alternatives.
+//! Neither the alternatives nor the variant need be polymorphic.
+//!
+//! @tparam Types The alternatives of the variant.
+//! @tparam Registry A @ref registry.
+template<class... Types, class Registry>
+struct virtual_traits<const std::variant<Types...>&, Registry> {
+    //! The variant type.
+    using virtual_type = std::variant<Types...>;
+
+    //! Return a reference to a non-modifiable variant.
+    //! @param arg A reference to a non-modifiable variant.
+    //! @return A reference to the same variant.
+    static auto peek(const std::variant<Types...>& arg)
+        -> const std::variant<Types...>& {
+        return arg;
+    }
+
+    //! Cast to an alternative.
+    //!
+    //! @tparam Derived A lvalue reference to an alternative, or to the
+    //! variant.
+    //! @param obj A reference to a non-modifiable variant.
+    //! @return A reference to the alternative held by the variant.
+    template<typename Derived>
+    static auto cast(const std::variant<Types...>& obj) -> Derived {
+        return detail::variant_cast<Derived>(obj);
+    }
+};
+
+//! Specialize virtual_traits for references to modifiable `std::variant`s.
+//!
+//! @tparam Types The alternatives of the variant.
+//! @tparam Registry A @ref registry.
+template<class... Types, class Registry>
+struct virtual_traits<std::variant<Types...>&, Registry> {
+    //! The variant type.
+    using virtual_type = std::variant<Types...>;
+
+    //! Return a reference to a non-modifiable variant.
+    //! @param arg A reference to a variant.
+    //! @return A reference to the same variant.
+    static auto peek(const std::variant<Types...>& arg)
+        -> const std::variant<Types...>& {
+        return arg;
+    }
+
+    //! Cast to an alternative.
+    //!
+    //! @tparam Derived A lvalue reference to an alternative, or to the
+    //! variant.
+    //! @param obj A reference to a variant.
+    //! @return A reference to the alternative held by the variant.
+    template<typename Derived>
+    static auto cast(std::variant<Types...>& obj) -> Derived {
+        return detail::variant_cast<Derived>(obj);
+    }
+};
+
 namespace detail {
 
 template<class...>
@@ -338,6 +486,7 @@ struct use_class_aux<Registry, mp11::mp_list<Class, Bases...>>
         this->last_base = bases + sizeof...(Bases);
         this->is_abstract = std::is_abstract_v<Class>;
         this->static_vptr = &Registry::template static_vptr<Class>;
+        this->static_vindex = &Registry::template static_vindex<Class>;
 
         if constexpr (!Registry::has_deferred_static_rtti) {
             resolve_type_ids();
@@ -358,15 +507,50 @@ struct use_class_aux<Registry, mp11::mp_list<Class, Bases...>>
 };
 
 template<class... Classes>
-using use_classes_tuple_type = boost::mp11::mp_apply<
-    std::tuple,
-    boost::mp11::mp_transform_q<
-        boost::mp11::mp_bind_front<
-            detail::use_class_aux,
-            typename detail::extract_registry<Classes...>::registry>,
-        boost::mp11::mp_apply<
-            detail::inheritance_map,
-            typename detail::extract_registry<Classes...>::others>>>;
+struct use_registered_classes {
+    using type = boost::mp11::mp_apply<
+        std::tuple,
+        boost::mp11::mp_transform_q<
+            boost::mp11::mp_bind_front<
+                detail::use_class_aux,
+                typename detail::extract_registry<Classes...>::registry>,
+            boost::mp11::mp_apply<
+                detail::inheritance_map,
+                typename detail::extract_registry<Classes...>::others>>>;
+};
+
+// Defined in static_registry.hpp.
+template<class StaticRegistry>
+struct static_registry_traits;
+
+// The classes of a static registry are known at compile time: `use_classes`
+// only checks that they are in the registry.
+template<class... Classes>
+struct use_static_classes {
+    using registry = boost::mp11::mp_back<boost::mp11::mp_list<Classes...>>;
+
+    static_assert(
+        boost::mp11::mp_all_of_q<
+            boost::mp11::mp_pop_back<boost::mp11::mp_list<Classes...>>,
+            boost::mp11::mp_bind_front<
+                boost::mp11::mp_contains,
+                typename static_registry_traits<
+                    typename registry::static_registry>::classes>>::value,
+        "classes must be listed in the static_registry");
+
+    // Not trivial, so that BOOST_OPENMETHOD_CLASSES does not define a variable
+    // that the compiler reports as unused.
+    struct type {
+        type() {
+        }
+    };
+};
+
+template<class... Classes>
+using use_classes_tuple_type = typename boost::mp11::mp_if_c<
+    is_static_registry<
+        boost::mp11::mp_back<boost::mp11::mp_list<void, Classes...>>>,
+    use_static_classes<Classes...>, use_registered_classes<Classes...>>::type;
 
 } // namespace detail
 
@@ -393,12 +577,18 @@ using use_classes_tuple_type = boost::mp11::mp_apply<
 //! overriders. The registry's `rtti` policy defines which casts are possible.
 //! For the @ref policies::std_rtti (the default), some scenarios involving
 //! repeated inheritance may not allow the cast.
+//!
+//! If the last argument is a @ref static_registry, `use_classes` registers
+//! nothing; it checks, at compile time, that the classes are listed in the
+//! registry. `use_classes` can also be used in the template arguments of a
+//! `static_registry`, to list its classes.
 template<class... Classes>
 class use_classes {
     detail::use_classes_tuple_type<Classes...> tuple;
 };
 
 void boost_openmethod_vptr(...);
+void boost_openmethod_vindex(...);
 
 // =============================================================================
 // virtual_ptr
@@ -507,20 +697,98 @@ constexpr bool has_vptr_fn = std::is_same_v<
         std::declval<const Class&>(), std::declval<Registry*>())),
     vptr_type>;
 
+inline vptr_type null_vptr = nullptr;
+
+// Under deferred_reclamation, returns the v-table pointer of the class with
+// index `vindex` in the current generation.
+template<class Registry>
+auto generation_vptr(const vindex_type& vindex) -> vptr_type {
+    // Load the generation first: it was published after `vindex` was assigned.
+    auto generation =
+        Registry::template policy<policies::deferred_reclamation>::current.load(
+            std::memory_order_acquire);
+
+    return generation->static_vptrs[vindex];
+}
+
 template<class Registry, class ArgType>
 decltype(auto) acquire_vptr(const ArgType& arg) {
     Registry::check_initialized();
 
-    if constexpr (detail::has_vptr_fn<ArgType, Registry>) {
+    if constexpr (is_variant<ArgType>) {
+        BOOST_ASSERT(!arg.valueless_by_exception());
+
+        if constexpr (Registry::has_deferred_reclamation) {
+            // `initialize` may be replacing the tables.
+            return generation_vptr<Registry>(
+                *variant_vindexes<Registry, ArgType>::value[arg.index()]);
+        } else {
+            return *variant_vptrs<Registry, ArgType>::value[arg.index()];
+        }
+    } else if constexpr (detail::has_vptr_fn<ArgType, Registry>) {
         return boost_openmethod_vptr(arg, static_cast<Registry*>(nullptr));
     } else {
+        if constexpr (Registry::has_fallback_dispatch) {
+            // The vptr policy is not initialized yet.
+            if (!Registry::is_initialized()) {
+                return static_cast<const vptr_type&>(null_vptr);
+            }
+        }
+
         return Registry::template policy<policies::vptr>::dynamic_vptr(arg);
     }
 }
 
-template<bool Indirect>
-inline auto box_vptr(const vptr_type& vp) {
-    if constexpr (Indirect) {
+// The cache is refreshed by `unbox_vptr`, called by the `const` member
+// functions of the `virtual_ptr` that owns the box, possibly concurrently.
+// `initialize` is not called concurrently with method calls, thus all the
+// threads that refresh the cache during an epoch store the same v-table
+// pointer. The pointer is stored before the epoch, with release semantics, so
+// a thread that reads the new epoch also reads the new pointer.
+template<class Registry>
+struct cached_vptr_box {
+    const vptr_type* vpp;
+    mutable std::atomic<vptr_type> vp;
+    mutable std::atomic<std::size_t> epoch;
+
+    cached_vptr_box() = default;
+
+    cached_vptr_box(
+        const vptr_type* vpp, vptr_type vp, std::size_t epoch) noexcept
+        : vpp(vpp), vp(vp), epoch(epoch) {
+    }
+
+    cached_vptr_box(const cached_vptr_box& other) noexcept : vpp(other.vpp) {
+        auto epoch = other.epoch.load(std::memory_order_acquire);
+        vp.store(
+            other.vp.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        this->epoch.store(epoch, std::memory_order_relaxed);
+    }
+
+    auto operator=(const cached_vptr_box& other) noexcept -> cached_vptr_box& {
+        auto epoch = other.epoch.load(std::memory_order_acquire);
+        vpp = other.vpp;
+        vp.store(
+            other.vp.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        this->epoch.store(epoch, std::memory_order_release);
+
+        return *this;
+    }
+};
+
+template<class Registry>
+using boxed_vptr = std::conditional_t<
+    Registry::has_cached_vptr, cached_vptr_box<Registry>,
+    std::conditional_t<
+        Registry::has_indirect_vptr, const vptr_type*, vptr_type>>;
+
+template<class Registry>
+inline auto box_vptr(const vptr_type& vp) -> boxed_vptr<Registry> {
+    if constexpr (Registry::has_cached_vptr) {
+        return {&vp, vp, Registry::epoch};
+    } else if constexpr (Registry::has_indirect_vptr) {
         return &vp;
     } else {
         return vp;
@@ -535,7 +803,58 @@ inline auto unbox_vptr(const vptr_type* vpp) {
     return *vpp;
 }
 
-inline vptr_type null_vptr = nullptr;
+template<class Registry>
+BOOST_FORCEINLINE auto unbox_vptr(const cached_vptr_box<Registry>& cvp) {
+    std::size_t epoch = Registry::epoch;
+
+    if (cvp.epoch.load(std::memory_order_acquire) != epoch) {
+        // The registry was re-initialized after the vptr was cached.
+        vptr_type vp = *cvp.vpp;
+        cvp.vp.store(vp, std::memory_order_relaxed);
+        cvp.epoch.store(epoch, std::memory_order_release);
+
+        return vp;
+    }
+
+    return cvp.vp.load(std::memory_order_relaxed);
+}
+
+// Under fallback_dispatch, a `virtual_ptr` to a polymorphic object made before
+// the dispatch data was published contains a null vptr. Acquire it again once
+// the registry is initialized.
+//
+// Under deferred_reclamation, a `virtual_ptr` made before the last call to
+// `initialize` contains a v-table pointer into a previous generation. Acquire
+// it again from the object. The generation is loaded again by the method call,
+// which resolves the call again if it changed meanwhile.
+template<class Registry, class Object>
+BOOST_FORCEINLINE auto
+unbox_vptr(const boxed_vptr<Registry>& boxed, const Object* obj) -> vptr_type {
+    vptr_type vp = unbox_vptr(boxed);
+
+    if constexpr (
+        Registry::has_fallback_dispatch && IsPolymorphic<Object, Registry>) {
+        if (!vp && obj && Registry::is_initialized()) {
+            return acquire_vptr<Registry>(*obj);
+        }
+    }
+
+    if constexpr (Registry::has_deferred_reclamation) {
+        static_assert(
+            IsPolymorphic<Object, Registry>,
+            "deferred_reclamation requires virtual_ptrs to polymorphic classes");
+
+        auto generation =
+            Registry::template policy<policies::deferred_reclamation>::current
+                .load(std::memory_order_acquire);
+
+        if (obj && generation && !generation->contains(vp)) {
+            return acquire_vptr<Registry>(*obj);
+        }
+    }
+
+    return vp;
+}
 
 } // namespace detail
 
@@ -586,10 +905,24 @@ inline auto final_virtual_ptr(Arg&& obj) {
         }
     }
 
-    return VirtualPtr(
-        std::forward<Arg>(obj),
-        detail::box_vptr<VirtualPtr::use_indirect_vptrs>(
-            Registry::template static_vptr<Class>));
+    if constexpr (Registry::has_deferred_reclamation) {
+        // A stale v-table pointer is acquired again from the object, using
+        // its dynamic type.
+        static_assert(
+            IsPolymorphic<Class, Registry>,
+            "deferred_reclamation requires final_virtual_ptr to take a "
+            "polymorphic class");
+
+        return VirtualPtr(
+            std::forward<Arg>(obj),
+            detail::box_vptr<Registry>(detail::generation_vptr<Registry>(
+                Registry::template static_vindex<Class>)));
+    } else {
+        return VirtualPtr(
+            std::forward<Arg>(obj),
+            detail::box_vptr<Registry>(
+                Registry::template static_vptr<Class>));
+    }
 }
 
 template<class Arg>
@@ -645,9 +978,8 @@ class virtual_ptr {
 #endif
 
     static constexpr bool is_smart_ptr = false;
-    static constexpr bool use_indirect_vptrs = Registry::has_indirect_vptr;
 
-    std::conditional_t<use_indirect_vptrs, const vptr_type*, vptr_type> vp;
+    detail::boxed_vptr<Registry> vp;
     Class* obj;
 
     template<
@@ -689,7 +1021,7 @@ class virtual_ptr {
     //!
     //! @param value A `nullptr`.
     explicit virtual_ptr(std::nullptr_t)
-        : vp(detail::box_vptr<use_indirect_vptrs>(detail::null_vptr)),
+        : vp(detail::box_vptr<Registry>(detail::null_vptr)),
           obj(nullptr) {
     }
 
@@ -736,7 +1068,7 @@ class virtual_ptr {
                 IsPolymorphic<Other, Registry> &&
             std::is_constructible_v<Class*, Other*>>>
     virtual_ptr(Other& other)
-        : vp(detail::box_vptr<use_indirect_vptrs>(
+        : vp(detail::box_vptr<Registry>(
               detail::acquire_vptr<Registry>(other))),
           obj(&other) {
     }
@@ -786,7 +1118,7 @@ class virtual_ptr {
                 IsPolymorphic<Class, Registry> &&
             std::is_constructible_v<Class*, Other*>>>
     virtual_ptr(Other* other)
-        : vp(detail::box_vptr<use_indirect_vptrs>(
+        : vp(detail::box_vptr<Registry>(
               detail::acquire_vptr<Registry>(*other))),
           obj(other) {
     }
@@ -899,7 +1231,7 @@ class virtual_ptr {
             std::is_assignable_v<Class*&, Other*>>>
     virtual_ptr& operator=(Other& other) {
         obj = &other;
-        vp = detail::box_vptr<use_indirect_vptrs>(
+        vp = detail::box_vptr<Registry>(
             detail::acquire_vptr<Registry>(other));
         return *this;
     }
@@ -949,7 +1281,7 @@ class virtual_ptr {
             std::is_assignable_v<Class*&, Other*>>>
     virtual_ptr& operator=(Other* other) {
         obj = other;
-        vp = detail::box_vptr<use_indirect_vptrs>(
+        vp = detail::box_vptr<Registry>(
             detail::acquire_vptr<Registry>(*other));
         return *this;
     }
@@ -1040,7 +1372,7 @@ class virtual_ptr {
     //! @endcode
     virtual_ptr& operator=(std::nullptr_t) {
         obj = nullptr;
-        vp = detail::box_vptr<use_indirect_vptrs>(detail::null_vptr);
+        vp = detail::box_vptr<Registry>(detail::null_vptr);
         return *this;
     }
 
@@ -1107,7 +1439,7 @@ class virtual_ptr {
     //! Get the v-table pointer
     //! @return The v-table pointer
     auto vptr() const {
-        return detail::unbox_vptr(this->vp);
+        return detail::unbox_vptr<Registry>(this->vp, obj);
     }
 };
 
@@ -1133,11 +1465,10 @@ class virtual_ptr<
 #endif
 
     static constexpr bool is_smart_ptr = true;
-    static constexpr bool use_indirect_vptrs = Registry::has_indirect_vptr;
 
     using traits = virtual_traits<SmartPtr, Registry>;
 
-    std::conditional_t<use_indirect_vptrs, const vptr_type*, vptr_type> vp;
+    detail::boxed_vptr<Registry> vp;
     SmartPtr obj;
 
     template<
@@ -1172,7 +1503,7 @@ class virtual_ptr<
     //! @par Example
     //! @endcode
     virtual_ptr()
-        : vp(detail::box_vptr<use_indirect_vptrs>(detail::null_vptr)) {
+        : vp(detail::box_vptr<Registry>(detail::null_vptr)) {
     }
 
     //! Construct from `nullptr`
@@ -1193,7 +1524,7 @@ class virtual_ptr<
     //!
     //! @param value A `nullptr`.
     explicit virtual_ptr(std::nullptr_t)
-        : vp(detail::box_vptr<use_indirect_vptrs>(detail::null_vptr)) {
+        : vp(detail::box_vptr<Registry>(detail::null_vptr)) {
     }
 
     virtual_ptr(const virtual_ptr& other) = default;
@@ -1201,7 +1532,7 @@ class virtual_ptr<
     virtual_ptr(virtual_ptr&& other)
         : vp(std::exchange(
               other.vp,
-              detail::box_vptr<use_indirect_vptrs>(detail::null_vptr))),
+              detail::box_vptr<Registry>(detail::null_vptr))),
           obj(std::move(other.obj)) {
     }
 
@@ -1239,7 +1570,7 @@ class virtual_ptr<
                 IsPolymorphic<typename Other::element_type, Registry> &&
             std::is_constructible_v<SmartPtr, const Other&>>>
     virtual_ptr(const Other& other)
-        : vp(detail::box_vptr<use_indirect_vptrs>(
+        : vp(detail::box_vptr<Registry>(
               other ? detail::acquire_vptr<Registry>(*other)
                     : detail::null_vptr)),
           obj(other) {
@@ -1279,7 +1610,7 @@ class virtual_ptr<
                 IsPolymorphic<typename Other::element_type, Registry> &&
             std::is_constructible_v<SmartPtr, Other&>>>
     virtual_ptr(Other& other)
-        : vp(detail::box_vptr<use_indirect_vptrs>(
+        : vp(detail::box_vptr<Registry>(
               other ? detail::acquire_vptr<Registry>(*other)
                     : detail::null_vptr)),
           obj(other) {
@@ -1322,7 +1653,7 @@ class virtual_ptr<
                 IsPolymorphic<typename Other::element_type, Registry> &&
             std::is_constructible_v<SmartPtr, Other&&>>>
     virtual_ptr(Other&& other)
-        : vp(detail::box_vptr<use_indirect_vptrs>(
+        : vp(detail::box_vptr<Registry>(
               other ? detail::acquire_vptr<Registry>(*other)
                     : detail::null_vptr)),
           obj(std::move(other)) {
@@ -1404,7 +1735,7 @@ class virtual_ptr<
     virtual_ptr(virtual_ptr<Other, Registry>&& other)
         : vp(std::exchange(
               other.vp,
-              detail::box_vptr<use_indirect_vptrs>(detail::null_vptr))),
+              detail::box_vptr<Registry>(detail::null_vptr))),
           obj(std::move(other.obj)) {
     }
 
@@ -1431,7 +1762,7 @@ class virtual_ptr<
     //! @param value A `nullptr`.
     virtual_ptr& operator=(std::nullptr_t) {
         obj = SmartPtr();
-        vp = detail::box_vptr<use_indirect_vptrs>(detail::null_vptr);
+        vp = detail::box_vptr<Registry>(detail::null_vptr);
         return *this;
     }
 
@@ -1469,7 +1800,7 @@ class virtual_ptr<
                 IsPolymorphic<typename Other::element_type, Registry>>>
     virtual_ptr& operator=(const Other& other) {
         obj = other;
-        vp = detail::box_vptr<use_indirect_vptrs>(
+        vp = detail::box_vptr<Registry>(
             detail::acquire_vptr<Registry>(*other));
         return *this;
     }
@@ -1508,7 +1839,7 @@ class virtual_ptr<
             BOOST_OPENMETHOD_DETAIL_UNLESS_MRDOCS
                 IsPolymorphic<typename Other::element_type, Registry>>>
     virtual_ptr& operator=(Other&& other) {
-        vp = detail::box_vptr<use_indirect_vptrs>(
+        vp = detail::box_vptr<Registry>(
             other ? detail::acquire_vptr<Registry>(*other) : detail::null_vptr);
         obj = std::move(other);
         return *this;
@@ -1641,7 +1972,7 @@ class virtual_ptr<
             std::is_assignable_v<SmartPtr, Other&&>>>
     virtual_ptr& operator=(virtual_ptr<Other, Registry>&& other) {
         vp = std::exchange(
-            other.vp, detail::box_vptr<use_indirect_vptrs>(detail::null_vptr));
+            other.vp, detail::box_vptr<Registry>(detail::null_vptr));
         obj = std::move(other.obj);
 
         return *this;
@@ -1731,7 +2062,7 @@ class virtual_ptr<
     //! Get the v-table pointer
     //! @return The v-table pointer
     auto vptr() const {
-        return detail::unbox_vptr(this->vp);
+        return detail::unbox_vptr<Registry>(this->vp, obj.get());
     }
 };
 
@@ -1891,7 +2222,9 @@ struct init_call_error {
 
         type_id arg_type_id;
 
-        if constexpr (Rtti::template is_polymorphic<Arg>) {
+        if constexpr (is_variant<Arg>) {
+            arg_type_id = variant_type<Rtti>(arg);
+        } else if constexpr (Rtti::template is_polymorphic<Arg>) {
             arg_type_id = Rtti::template dynamic_type<Arg>(arg);
         } else {
             arg_type_id = Rtti::template static_type<Arg>();
@@ -1912,6 +2245,352 @@ struct init_call_error<Method, Rtti, call_error::max_types> {
     }
 };
 
+// Resolves method calls without the dispatch tables, by walking the
+// overriders and the classes' bases. Used by the fallback_dispatch policy.
+template<class Registry>
+struct fallback_resolver {
+    using rtti = typename Registry::rtti;
+
+    static auto same_class(type_id a, type_id b) -> bool {
+        return rtti::type_index(a) == rtti::type_index(b);
+    }
+
+    using type_index_type =
+        decltype(rtti::type_index(std::declval<type_id>()));
+
+    static auto
+    collect_ancestors(type_id type, std::vector<type_index_type>& ancestors)
+        -> void {
+        for (auto& cls : Registry::classes) {
+            if (!same_class(cls.type, type)) {
+                continue;
+            }
+
+            for (auto base_iter = cls.first_base; base_iter != cls.last_base;
+                 ++base_iter) {
+                // Classes are registered as their own improper bases.
+                auto base = rtti::type_index(*base_iter);
+
+                if (std::find(ancestors.begin(), ancestors.end(), base) ==
+                    ancestors.end()) {
+                    ancestors.push_back(base);
+                    collect_ancestors(*base_iter, ancestors);
+                }
+            }
+        }
+    }
+
+    using ancestors_ptr = std::shared_ptr<const std::vector<type_index_type>>;
+
+    struct ancestors_memo {
+        std::shared_mutex mutex;
+        std::unordered_map<type_index_type, ancestors_ptr> entries;
+        std::size_t epoch = 0;
+    };
+
+    // The class and its direct and indirect bases, computed on first use. A
+    // function-local static, because methods may be called during static
+    // initialization.
+    static auto memo() -> ancestors_memo& {
+        static ancestors_memo instance;
+
+        return instance;
+    }
+
+    // The memo is filled during the first calls, then only read: look up
+    // under a shared lock. The classes may change between initializations,
+    // thus the memo is discarded when the registry's epoch changes. Calls in
+    // progress keep the entries they use alive.
+    static auto ancestors(type_id type) -> ancestors_ptr {
+        auto& memo = fallback_resolver::memo();
+        auto index = rtti::type_index(type);
+        std::size_t epoch = Registry::epoch;
+
+        {
+            std::shared_lock<std::shared_mutex> lock(memo.mutex);
+
+            if (memo.epoch == epoch) {
+                auto iter = memo.entries.find(index);
+
+                if (iter != memo.entries.end()) {
+                    return iter->second;
+                }
+            }
+        }
+
+        auto ancestors = std::make_shared<std::vector<type_index_type>>(
+            std::vector<type_index_type>{index});
+        collect_ancestors(type, *ancestors);
+
+        std::lock_guard<std::shared_mutex> lock(memo.mutex);
+
+        if (memo.epoch != epoch) {
+            memo.entries.clear();
+            memo.epoch = epoch;
+        }
+
+        return memo.entries.try_emplace(index, std::move(ancestors))
+            .first->second;
+    }
+
+    static auto contains(
+        const std::vector<type_index_type>& ancestors, type_id base) -> bool {
+        return std::find(
+                   ancestors.begin(), ancestors.end(),
+                   rtti::type_index(base)) != ancestors.end();
+    }
+
+    // `true` if `derived` is `base`, or is derived from it.
+    static auto is_base_of(type_id base, type_id derived) -> bool {
+        return same_class(base, derived) || contains(*ancestors(derived), base);
+    }
+
+    static auto
+    is_more_specific(const overrider_info& a, const overrider_info& b) -> bool {
+        auto result = false;
+        auto b_iter = b.vp_begin;
+
+        for (auto a_iter = a.vp_begin; a_iter != a.vp_end; ++a_iter, ++b_iter) {
+            if (same_class(*a_iter, *b_iter)) {
+                continue;
+            }
+
+            if (!is_base_of(*b_iter, *a_iter)) {
+                return false;
+            }
+
+            result = true;
+        }
+
+        return result;
+    }
+
+    // Selects the most specific overrider applicable to `types`, skipping
+    // `excluded`.
+    template<std::size_t Arity>
+    static auto resolve(
+        const method_info& method, const type_id* types,
+        const overrider_info* excluded = nullptr) -> void (*)() {
+        ancestors_ptr arg_ancestors[Arity];
+
+        for (std::size_t i = 0; i < Arity; ++i) {
+            arg_ancestors[i] = ancestors(types[i]);
+        }
+
+        // The applicable overriders, in a fixed buffer. A vector is used only
+        // if they don't fit.
+        constexpr std::size_t buffer_size = 16;
+        const overrider_info* buffer[buffer_size];
+        std::vector<const overrider_info*> overflow;
+        std::size_t count = 0;
+
+        for (auto& spec : method.specs) {
+            if (&spec == excluded) {
+                continue;
+            }
+
+            auto ancestors_iter = arg_ancestors;
+
+            if (!std::all_of(spec.vp_begin, spec.vp_end, [&](type_id vp) {
+                    return contains(**ancestors_iter++, vp);
+                })) {
+                continue;
+            }
+
+            if (count == buffer_size) {
+                overflow.assign(buffer, buffer + buffer_size);
+            }
+
+            if (count < buffer_size) {
+                buffer[count] = &spec;
+            } else {
+                overflow.push_back(&spec);
+            }
+
+            ++count;
+        }
+
+        auto first = count <= buffer_size ? buffer : overflow.data();
+        auto last = first + count;
+        const overrider_info* best = nullptr;
+        std::size_t dominants = 0;
+
+        for (auto candidate : range{first, last}) {
+            if (std::none_of(first, last, [&](auto other) {
+                    return is_more_specific(*other, *candidate);
+                })) {
+                if (!best) {
+                    best = candidate;
+                }
+
+                ++dominants;
+            }
+        }
+
+        if (dominants == 0) {
+            return method.not_implemented;
+        }
+
+        if constexpr (!Registry::has_n2216) {
+            if (dominants > 1) {
+                return method.ambiguous;
+            }
+        }
+
+        return best->pf;
+    }
+};
+
+template<class Registry, typename MethodArgList>
+struct fallback_type_ids {
+    template<typename ArgType, typename... MoreArgTypes>
+    static auto
+    fn(type_id* ids, const ArgType& arg, const MoreArgTypes&... more_args) {
+        using namespace boost::mp11;
+
+        if constexpr (is_virtual<mp_first<MethodArgList>>::value) {
+            if constexpr (is_virtual_ptr<ArgType>) {
+                *ids++ = Registry::rtti::dynamic_type(*arg);
+            } else if constexpr (is_variant<ArgType>) {
+                *ids++ = variant_type<typename Registry::rtti>(arg);
+            } else {
+                *ids++ = Registry::rtti::dynamic_type(arg);
+            }
+        }
+
+        if constexpr (sizeof...(MoreArgTypes) != 0) {
+            fallback_type_ids<Registry, mp_rest<MethodArgList>>::fn(
+                ids, more_args...);
+        }
+    }
+};
+
+// Resolves a call to an interpreted method, given the group of each virtual
+// argument. See registry::compiler::write_interpreted_data for the layout of
+// the data.
+template<class Registry, std::size_t Arity>
+auto interpret(const method_info& method, const std::size_t* groups)
+    -> void (*)() {
+    constexpr std::size_t bits = sizeof(std::size_t) * CHAR_BIT;
+
+    auto data = method.interpreter_data;
+    auto specs = data[1].i, words = data[2].i;
+    auto pfs = data + data[4 + Arity].i;
+
+    auto applicable = [data, groups, words](std::size_t w) {
+        auto mask = ~std::size_t(0);
+
+        for (std::size_t dim = 0; dim < Arity; ++dim) {
+            mask &= data[data[3 + dim].i + groups[dim] * words + w].i;
+        }
+
+        return mask;
+    };
+
+    // The overriders are sorted from the most specific to the least specific,
+    // so the first applicable overrider is not dominated by any other.
+    auto best = specs;
+
+    for (std::size_t w = 0; w < words; ++w) {
+        if (auto mask = applicable(w)) {
+            best = w * bits;
+
+            for (; !(mask & 1); mask >>= 1) {
+                ++best;
+            }
+
+            break;
+        }
+    }
+
+    if (best == specs) {
+        return pfs[specs].pf;
+    }
+
+    if constexpr (!Registry::has_n2216) {
+        // It is the best overrider only if it dominates all the others.
+        auto dominated = data + data[3 + Arity].i + best * words;
+
+        for (std::size_t w = 0; w < words; ++w) {
+            auto others = applicable(w) & ~dominated[w].i;
+
+            if (w == best / bits) {
+                others &= ~(std::size_t(1) << best % bits);
+            }
+
+            if (others) {
+                return pfs[specs + 1].pf;
+            }
+        }
+    }
+
+    return pfs[best].pf;
+}
+
+// A small, least recently used cache of the results of `interpret`. Each
+// thread has its own cache, thus lookups do not take a lock. It is constant
+// initialized, thus a `thread_local` instance does not need a guard.
+template<std::size_t Arity, std::size_t Size>
+class interpreted_cache {
+  public:
+    auto find(std::size_t epoch, const std::size_t* groups) -> void (*)() {
+        if (epoch != this->epoch) {
+            // The groups were renumbered by a new initialization.
+            std::fill(std::begin(entries), std::end(entries), entry());
+            this->epoch = epoch;
+
+            return nullptr;
+        }
+
+        for (auto& entry : entries) {
+            if (entry.pf && std::equal(groups, groups + Arity, entry.groups)) {
+                entry.used = ++clock;
+
+                return entry.pf;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void insert(std::size_t epoch, const std::size_t* groups, void (*pf)()) {
+        if (epoch != this->epoch) {
+            return;
+        }
+
+        auto lru = std::min_element(
+            std::begin(entries), std::end(entries),
+            [](auto& a, auto& b) { return a.used < b.used; });
+        std::copy(groups, groups + Arity, lru->groups);
+        lru->pf = pf;
+        lru->used = ++clock;
+    }
+
+  private:
+    struct entry {
+        std::size_t groups[Arity] = {};
+        void (*pf)() = nullptr;
+        std::size_t used = 0;
+    };
+
+    entry entries[Size];
+    std::size_t clock = 0;
+    std::size_t epoch = 0;
+};
+
+// Calls `pf` with the arguments at positions `First` and `Second` swapped.
+template<
+    std::size_t First, std::size_t Second, typename FunctionPointer,
+    class Tuple, std::size_t... Indices>
+auto call_swapped(
+    FunctionPointer pf, Tuple&& args, std::index_sequence<Indices...>)
+    -> decltype(auto) {
+    return pf(std::get<(
+                  Indices == First    ? Second
+                      : Indices == Second ? First
+                                          : Indices)>(std::move(args))...);
+}
+
 template<class Method>
 struct static_offsets;
 
@@ -1967,6 +2646,7 @@ struct validate_method_parameter<
     std::void_t<typename virtual_traits<T, Registry>::virtual_type>>
     : std::bool_constant<
           has_vptr_fn<virtual_type<T, Registry>, Registry> ||
+          is_variant<virtual_type<T, Registry>> ||
           Registry::rtti::template is_polymorphic<virtual_type<T, Registry>>> {
     static_assert(
         validate_method_parameter::value,
@@ -1986,6 +2666,37 @@ struct validate_method_parameter<
 };
 } // namespace detail
 
+//! Requests interpreted dispatch for a method.
+//!
+//! Specialize this template as a true type for a multi-method, to resolve
+//! calls to it without a dispatch table, if the registry contains a @ref
+//! policies::interpreted_dispatch policy.
+//!
+//! @tparam Method A specialization of @ref method.
+template<class Method>
+struct interpreted_method : std::false_type {};
+
+//! Declares a method as symmetric.
+//!
+//! Specialize this template as a true type for a method with two virtual
+//! parameters of the same type, to declare that the order of the virtual
+//! arguments does not matter. An overrider for `(A, B)` is then also used for
+//! calls with arguments of types `B` and `A`, which it receives in its own
+//! order. Thus overriders for both `(A, B)` and `(B, A)` are ambiguous.
+//!
+//! The dispatch table contains only the cells where the group of the first
+//! argument is less than, or equal to, the group of the second argument - about
+//! half of the cells. Calls order the two groups, and swap the arguments when
+//! needed.
+//!
+//! The specialization must be visible before the method's overriders are
+//! defined. Symmetric methods cannot be used with the @ref
+//! policies::fallback_dispatch policy.
+//!
+//! @tparam Method A specialization of @ref method.
+template<class Method>
+struct symmetric_method : std::false_type {};
+
 //! Implement a method
 //!
 //! Methods are created by specializing the `method` class template with an
@@ -2138,15 +2849,59 @@ class method<Id, ReturnType(Parameters...), Registry>
     //! A pointer to the next most specialized overrider after `Fn`, i.e. the
     //! overrider that would be called for the same tuple of virtual arguments
     //! if `Fn` was not present. Set to `nullptr` if no such overrider exists.
+    //!
+    //! `next` is a callable object that contains the pointer. The pointer is
+    //! written atomically by @ref initialize and @ref replace, and read
+    //! atomically each time `next` is called. Thus overriders can call `next`
+    //! while @ref initialize or @ref initialize_async is running.
+    //!
     //! @par Requirements
     //!
     //! `Fn` must be a function that is an overrider of the method.
     //!
     //! @tparam Fn A function that is an overrider of the method.
     template<auto Fn>
-    inline static ReturnType (*next)(
+    inline static detail::next_ptr<ReturnType (*)(
         typename BOOST_OPENMETHOD_DETAIL_UNLESS_MRDOCS
-            StripVirtualDecorator<Parameters>::type... args);
+            StripVirtualDecorator<Parameters>::type...)>
+        next;
+
+    //! Replace an overrider in the dispatch data
+    //!
+    //! Replaces overrider `Old` with `New`, without calling @ref initialize.
+    //! Every dispatch table cell and v-table entry that designates `Old` is
+    //! rewritten to designate `New`, as are the @ref next pointers of the
+    //! other overriders. `next<New>` is set to `next<Old>`. The replacement
+    //! persists across subsequent calls to `initialize`.
+    //!
+    //! `replace` rewrites only the cells of the method: the dispatch table
+    //! cells, as recorded by `initialize`, and the v-table entries of the
+    //! classes derived from the first virtual parameter. It is linear in the
+    //! size of the method's dispatch table and in the number of classes, and
+    //! does not rebuild the dispatch data.
+    //! Each cell is rewritten atomically, thus `replace` can be called while
+    //! the method is being called in other threads: each call uses either
+    //! `Old` or `New`. It must not be called while `initialize` is running.
+    //!
+    //! If the registry contains the @ref policies::compact_dispatch policy, and
+    //! `New` is too far from the registry's code to be stored as a 32-bit
+    //! offset, and if the registry contains an @ref policies::error_handler
+    //! policy, its `error` function is called with a @ref code_offset_error
+    //! object, then the program is terminated with @ref abort. In that case,
+    //! nothing has been modified.
+    //!
+    //! @par Requirements
+    //!
+    //! `Old` and `New` must be functions with the same virtual parameter
+    //! types. `Old` must be an overrider of the method. The registry must not
+    //! contain the @ref policies::lazy_dispatch or
+    //! @ref policies::position_independent policies.
+    //!
+    //! @tparam Old An overrider of the method.
+    //! @tparam New The replacement.
+    //! @return `true` if `Old` was found and replaced.
+    template<auto Old, auto New>
+    static auto replace() -> bool;
 
     //! Add overriders to method
     //!
@@ -2196,6 +2951,13 @@ class method<Id, ReturnType(Parameters...), Registry>
         -> ReturnType;
     static constexpr auto Arity = boost::mp11::mp_count_if<
         mp11::mp_list<Parameters...>, detail::is_virtual>::value;
+    // Positions of the virtual parameters of symmetric methods.
+    static constexpr std::size_t FirstVirtual =
+        mp11::mp_find_if<DeclaredParameters, detail::is_virtual>::value;
+    static constexpr std::size_t SecondVirtual = FirstVirtual + 1 +
+        mp11::mp_find_if<
+            mp11::mp_drop_c<DeclaredParameters, FirstVirtual + 1>,
+            detail::is_virtual>::value;
 
     // sanity checks
     static_assert((
@@ -2218,6 +2980,10 @@ class method<Id, ReturnType(Parameters...), Registry>
     template<typename ArgType>
     auto vptr(const ArgType& arg) const -> vptr_type;
 
+    auto slots_strides_data() const -> const std::size_t*;
+
+    static auto code(detail::word cell) -> void (*)();
+
     template<class Error>
     auto
     check_static_offset(std::size_t actual, std::size_t expected) const -> void;
@@ -2232,10 +2998,10 @@ class method<Id, ReturnType(Parameters...), Registry>
         const MoreArgTypes&... more_args) const -> detail::word;
 
     template<
-        std::size_t VirtualArg, typename MethodArgList, typename ArgType,
-        typename... MoreArgTypes>
+        std::size_t VirtualArg, typename MethodArgList, typename Cell,
+        typename ArgType, typename... MoreArgTypes>
     auto resolve_multi_next(
-        vptr_type dispatch, const ArgType& arg,
+        const Cell* dispatch, const ArgType& arg,
         const MoreArgTypes&... more_args) const -> detail::word;
 
     template<typename... ArgType>
@@ -2258,6 +3024,18 @@ class method<Id, ReturnType(Parameters...), Registry>
         detail::remove_virtual_<Parameters>... args) -> ReturnType;
     static BOOST_NORETURN auto
     fn_ambiguous(detail::remove_virtual_<Parameters>... args) -> ReturnType;
+    static auto
+    fn_lazy(detail::remove_virtual_<Parameters>... args) -> ReturnType;
+    static auto
+    fn_interpreted(detail::remove_virtual_<Parameters>... args) -> ReturnType;
+
+    template<typename... Args>
+    static auto call_swapped(FunctionPointer pf, Args&&... args) -> ReturnType;
+
+    template<typename MethodArgList, typename ArgType, typename... MoreArgTypes>
+    void collect_vptrs(
+        vptr_type* vptrs, const ArgType& arg,
+        const MoreArgTypes&... more_args) const;
 
     template<
         auto Overrider, typename OverriderReturn,
@@ -2275,12 +3053,21 @@ class method<Id, ReturnType(Parameters...), Registry>
         : std::conditional_t<
               Registry::has_deferred_static_rtti,
               detail::deferred_overrider_info, detail::overrider_info> {
-        explicit override_impl(FunctionPointer* next = nullptr);
+        explicit override_impl(detail::next_ptr<FunctionPointer>* next = nullptr);
         void resolve_type_ids();
+        static auto fallback_next(detail::remove_virtual_<Parameters>... args)
+            -> ReturnType;
+        static auto swapped(detail::remove_virtual_<Parameters>... args)
+            -> ReturnType;
 
         inline static type_id vp_type_ids[Arity];
+        inline static override_impl* instance;
     };
 
+    template<auto Function, typename FnReturnType, typename... FnParameters>
+    static auto override_impl_of(FnReturnType (*)(FnParameters...))
+        -> override_impl<Function, FnReturnType>;
+
     template<auto Function, typename FunctionType>
     struct override_aux;
 
@@ -2341,6 +3128,17 @@ method<Id, ReturnType(Parameters...), Registry>::method() {
         this->ambiguous = reinterpret_cast<void (*)()>(fn_ambiguous);
     }
 
+    if constexpr (Registry::has_lazy_dispatch) {
+        this->lazy_resolver = reinterpret_cast<void (*)()>(fn_lazy);
+    }
+
+    if constexpr (Registry::has_interpreted_dispatch) {
+        this->interpreter = reinterpret_cast<void (*)()>(fn_interpreted);
+        this->interpreted = interpreted_method<method>::value;
+    }
+
+    this->symmetric = symmetric_method<method>::value;
+
     Registry::methods.push_back(*this);
 }
 
@@ -2369,6 +3167,34 @@ method<Id, ReturnType(Parameters...), Registry>::~method() {
     Registry::methods.remove(*this);
 }
 
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+BOOST_FORCEINLINE auto
+method<Id, ReturnType(Parameters...), Registry>::slots_strides_data() const
+    -> const std::size_t* {
+    if constexpr (Registry::has_deferred_reclamation) {
+        return Registry::template policy<policies::deferred_reclamation>::
+            current.load(std::memory_order_acquire)
+                ->slots_strides[this->index];
+    } else {
+        return slots_strides;
+    }
+}
+
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+BOOST_FORCEINLINE auto
+method<Id, ReturnType(Parameters...), Registry>::code(detail::word cell)
+    -> void (*)() {
+    if constexpr (Registry::has_position_independent) {
+        // An offset from the registry's origin.
+        return reinterpret_cast<void (*)()>(
+            reinterpret_cast<std::uintptr_t>(&Registry::code_origin) + cell.i);
+    } else {
+        return cell.pf;
+    }
+}
+
 template<
     typename Id, typename... Parameters, typename ReturnType, class Registry>
 template<class Error>
@@ -2380,7 +3206,7 @@ auto method<Id, ReturnType(Parameters...), Registry>::check_static_offset(
         if (actual != expected) {
             Error error;
             error.method = Registry::rtti::template static_type<method>();
-            error.expected = this->slots_strides[0];
+            error.expected = this->slots_strides_data()[0];
             error.actual = actual;
             Registry::error_handler::error(error);
 
@@ -2399,10 +3225,91 @@ method<Id, ReturnType(Parameters...), Registry>::operator()(
     typename BOOST_OPENMETHOD_DETAIL_UNLESS_MRDOCS
         StripVirtualDecorator<Parameters>::type... args) const -> ReturnType {
     using namespace detail;
-    auto pf = resolve(parameter_traits<Parameters, Registry>::peek(args)...);
 
-    return pf(std::forward<typename StripVirtualDecorator<Parameters>::type>(
-        args)...);
+    if constexpr (symmetric_method<method>::value) {
+        static_assert(
+            Arity == 2, "symmetric methods take two virtual arguments");
+        static_assert(
+            std::is_same_v<
+                mp11::mp_at_c<DeclaredParameters, FirstVirtual>,
+                mp11::mp_at_c<DeclaredParameters, SecondVirtual>>,
+            "the virtual parameters of a symmetric method must be the same");
+        static_assert(
+            !Registry::has_fallback_dispatch,
+            "symmetric methods do not support fallback_dispatch");
+        static_assert(
+            !Registry::has_deferred_reclamation,
+            "symmetric methods do not support deferred_reclamation");
+
+        Registry::check_initialized();
+
+        vptr_type vptrs[2];
+        collect_vptrs<DeclaredParameters>(
+            vptrs, parameter_traits<Parameters, Registry>::peek(args)...);
+
+        // The table is triangular: it contains the cells where the group of
+        // the first argument is less than, or equal to, the group of the
+        // second argument.
+        auto first = vptrs[0][slots_strides_data()[0]].i;
+        auto second = vptrs[1][slots_strides_data()[1]].i;
+
+        if (first <= second) {
+            auto pf = reinterpret_cast<FunctionPointer>(
+                code(this->symmetric_table[second * (second + 1) / 2 + first]));
+
+            if constexpr (Registry::has_instrumentation) {
+                Registry::instrumentation::count(
+                    *this, reinterpret_cast<void (*)()>(pf));
+            }
+
+            return pf(
+                std::forward<typename StripVirtualDecorator<Parameters>::type>(
+                    args)...);
+        }
+
+        auto pf = reinterpret_cast<FunctionPointer>(
+            code(this->symmetric_table[first * (first + 1) / 2 + second]));
+
+        if constexpr (Registry::has_instrumentation) {
+            Registry::instrumentation::count(
+                *this, reinterpret_cast<void (*)()>(pf));
+        }
+
+        return call_swapped(
+            pf,
+            std::forward<typename StripVirtualDecorator<Parameters>::type>(
+                args)...);
+    } else {
+        auto pf =
+            resolve(parameter_traits<Parameters, Registry>::peek(args)...);
+
+        if constexpr (Registry::has_instrumentation) {
+            // The trampolines are not overriders: fn_lazy calls the method
+            // again, and fn_interpreted counts the overrider it selects.
+            auto counted = reinterpret_cast<void (*)()>(pf);
+
+            if ((!Registry::has_lazy_dispatch ||
+                 counted != this->lazy_resolver) &&
+                (!Registry::has_interpreted_dispatch ||
+                 counted != this->interpreter)) {
+                Registry::instrumentation::count(*this, counted);
+            }
+        }
+
+        return pf(
+            std::forward<typename StripVirtualDecorator<Parameters>::type>(
+                args)...);
+    }
+}
+
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<typename... Args>
+auto method<Id, ReturnType(Parameters...), Registry>::call_swapped(
+    FunctionPointer pf, Args&&... args) -> ReturnType {
+    return detail::call_swapped<FirstVirtual, SecondVirtual>(
+        pf, std::forward_as_tuple(std::forward<Args>(args)...),
+        std::index_sequence_for<Args...>());
 }
 
 template<
@@ -2418,12 +3325,50 @@ BOOST_FORCEINLINE
 
     void (*pf)();
 
-    if constexpr (Arity == 1) {
-        pf = resolve_uni<mp11::mp_list<Parameters...>, ArgType...>(args...).pf;
+    if constexpr (Registry::has_fallback_dispatch) {
+        if (!Registry::is_initialized()) {
+            type_id types[Arity];
+            fallback_type_ids<Registry, mp11::mp_list<Parameters...>>::fn(
+                types, args...);
+
+            return reinterpret_cast<FunctionPointer>(
+                fallback_resolver<Registry>::template resolve<Arity>(
+                    *this, types));
+        }
+    }
+
+    if constexpr (Registry::has_deferred_reclamation) {
+        // The slots, strides and v-table pointers are loaded from the current
+        // generation, each time via an acquire load. Generations are never
+        // reused before `reclaim`, thus if the generation is the same after
+        // resolution as before it, all the loads read from it.
+        auto& current =
+            Registry::template policy<policies::deferred_reclamation>::current;
+        auto generation = current.load(std::memory_order_acquire);
+
+        for (;;) {
+            if constexpr (Arity == 1) {
+                pf = code(resolve_uni<mp11::mp_list<Parameters...>, ArgType...>(
+                    args...));
+            } else {
+                pf = code(resolve_multi_first<
+                          mp11::mp_list<Parameters...>, ArgType...>(args...));
+            }
+
+            auto after = current.load(std::memory_order_acquire);
+
+            if (after == generation) {
+                break;
+            }
+
+            generation = after;
+        }
+    } else if constexpr (Arity == 1) {
+        pf = code(
+            resolve_uni<mp11::mp_list<Parameters...>, ArgType...>(args...));
     } else {
-        pf = resolve_multi_first<mp11::mp_list<Parameters...>, ArgType...>(
-                 args...)
-                 .pf;
+        pf = code(resolve_multi_first<mp11::mp_list<Parameters...>, ArgType...>(
+            args...));
     }
 
     return reinterpret_cast<FunctionPointer>(pf);
@@ -2455,15 +3400,24 @@ method<Id, ReturnType(Parameters...), Registry>::resolve_uni(
 
     if constexpr (is_virtual<mp_first<MethodArgList>>::value) {
         vptr_type vtbl = vptr<ArgType>(arg);
+        std::size_t slot;
 
         if constexpr (has_static_offsets<method>::value) {
             if constexpr (Registry::has_runtime_checks) {
                 check_static_offset<static_slot_error>(
-                    static_offsets<method>::slots[0], this->slots_strides[0]);
+                    static_offsets<method>::slots[0],
+                    this->slots_strides_data()[0]);
             }
-            return vtbl[static_offsets<method>::slots[0]];
+            slot = static_offsets<method>::slots[0];
+        } else {
+            slot = this->slots_strides_data()[0];
+        }
+
+        if constexpr (Registry::has_lazy_dispatch) {
+            // The entry may be written concurrently by the method's builder.
+            return load_acquire(vtbl[slot]);
         } else {
-            return vtbl[this->slots_strides[0]];
+            return vtbl[slot];
         }
     } else {
         return resolve_uni<mp_rest<MethodArgList>>(more_args...);
@@ -2489,18 +3443,54 @@ method<Id, ReturnType(Parameters...), Registry>::resolve_multi_first(
             slot = static_offsets<method>::slots[0];
             if constexpr (Registry::has_runtime_checks) {
                 check_static_offset<static_slot_error>(
-                    static_offsets<method>::slots[0], this->slots_strides[0]);
+                    static_offsets<method>::slots[0],
+                    this->slots_strides_data()[0]);
             }
         } else {
-            slot = this->slots_strides[0];
+            slot = this->slots_strides_data()[0];
         }
 
         // The first virtual parameter is special.  Since its stride is
         // 1, there is no need to store it. Also, the method table
         // contains a pointer into the multi-dimensional dispatch table,
         // already resolved to the appropriate group.
-        auto dispatch = vtbl[slot].pw;
-        return resolve_multi_next<1, mp_rest<MethodArgList>, MoreArgTypes...>(
+        if constexpr (Registry::has_inline_rows && Arity == 2) {
+            if (this->inline_row) {
+                // The row of the dispatch table for the group of the first
+                // argument is stored in its v-table.
+                return resolve_multi_next<1, mp_rest<MethodArgList>>(
+                    vtbl + slot, more_args...);
+            }
+        }
+
+        if constexpr (Registry::has_compact_dispatch) {
+            auto cells = reinterpret_cast<const std::atomic<std::int32_t>*>(
+                vtbl[slot].pw);
+
+            return resolve_multi_next<1, mp_rest<MethodArgList>>(
+                cells, more_args...);
+        }
+
+        const word* dispatch;
+
+        if constexpr (Registry::has_lazy_dispatch) {
+            // The entry is written, with release semantics, after the strides
+            // and the entries for the other arguments.
+            dispatch = load_acquire(vtbl[slot]).pw;
+
+            // The dispatch table of the method has not been built yet. Do not
+            // apply the strides, they may be in the process of being set.
+            if (dispatch->pf == this->lazy_resolver) {
+                return *dispatch;
+            }
+        } else if constexpr (Registry::has_position_independent) {
+            // An offset from the v-table entry.
+            dispatch = vtbl + slot + std::ptrdiff_t(vtbl[slot].i);
+        } else {
+            dispatch = vtbl[slot].pw;
+        }
+
+        return resolve_multi_next<1, mp_rest<MethodArgList>>(
             dispatch, more_args...);
     } else {
         return resolve_multi_first<mp_rest<MethodArgList>, MoreArgTypes...>(
@@ -2511,11 +3501,11 @@ method<Id, ReturnType(Parameters...), Registry>::resolve_multi_first(
 template<
     typename Id, typename... Parameters, typename ReturnType, class Registry>
 template<
-    std::size_t VirtualArg, typename MethodArgList, typename ArgType,
-    typename... MoreArgTypes>
+    std::size_t VirtualArg, typename MethodArgList, typename Cell,
+    typename ArgType, typename... MoreArgTypes>
 BOOST_FORCEINLINE auto
 method<Id, ReturnType(Parameters...), Registry>::resolve_multi_next(
-    vptr_type dispatch, const ArgType& arg,
+    const Cell* dispatch, const ArgType& arg,
     const MoreArgTypes&... more_args) const -> detail::word {
 
     using namespace detail;
@@ -2531,23 +3521,42 @@ method<Id, ReturnType(Parameters...), Registry>::resolve_multi_next(
 
             if constexpr (Registry::has_runtime_checks) {
                 check_static_offset<static_slot_error>(
-                    this->slots_strides[VirtualArg], slot);
+                    this->slots_strides_data()[VirtualArg], slot);
                 check_static_offset<static_stride_error>(
-                    this->slots_strides[2 * VirtualArg], stride);
+                    this->slots_strides_data()[2 * VirtualArg], stride);
             }
         } else {
-            slot = this->slots_strides[VirtualArg];
-            stride = this->slots_strides[Arity + VirtualArg - 1];
+            slot = this->slots_strides_data()[VirtualArg];
+            stride = this->slots_strides_data()[Arity + VirtualArg - 1];
         }
 
-        dispatch = dispatch + vtbl[slot].i * stride;
-    }
+        if constexpr (Registry::has_premultiplied_strides) {
+            // The v-table entry is the offset in the table. The stride is not
+            // used, and not loaded.
+            dispatch = dispatch + vtbl[slot].i;
+        } else if constexpr (Registry::has_power_of_two_strides) {
+            // The stride is a shift.
+            dispatch = dispatch + (vtbl[slot].i << stride);
+        } else {
+            dispatch = dispatch + vtbl[slot].i * stride;
+        }
 
-    if constexpr (VirtualArg + 1 == Arity) {
-        return *dispatch;
+        if constexpr (VirtualArg + 1 == Arity) {
+            if constexpr (std::is_same_v<Cell, std::atomic<std::int32_t>>) {
+                // compact_dispatch: an offset from the registry's origin
+                return reinterpret_cast<void (*)()>(
+                    reinterpret_cast<std::uintptr_t>(&Registry::code_origin) +
+                    std::intptr_t(dispatch->load(std::memory_order_relaxed)));
+            } else {
+                return *dispatch;
+            }
+        } else {
+            return resolve_multi_next<VirtualArg + 1, mp_rest<MethodArgList>>(
+                dispatch, more_args...);
+        }
     } else {
-        return resolve_multi_next<
-            VirtualArg + 1, mp_rest<MethodArgList>, MoreArgTypes...>(
+        // Non-virtual parameters don't count.
+        return resolve_multi_next<VirtualArg, mp_rest<MethodArgList>>(
             dispatch, more_args...);
     }
 }
@@ -2560,12 +3569,29 @@ template<
 template<auto Fn>
 inline auto
 method<Id, ReturnType(Parameters...), Registry>::has_next() -> bool {
-    if (next<Fn> == fn_not_implemented) {
+    FunctionPointer pf;
+
+    if constexpr (Registry::has_fallback_dispatch) {
+        if (!Registry::is_initialized()) {
+            // `next` holds `fallback_next` until the dispatch data is
+            // published: resolve the next overrider the same way it does.
+            using Impl = decltype(override_impl_of<Fn>(Fn));
+            pf = reinterpret_cast<FunctionPointer>(
+                detail::fallback_resolver<Registry>::template resolve<Arity>(
+                    fn, Impl::instance->vp_begin, Impl::instance));
+        } else {
+            pf = next<Fn>.load();
+        }
+    } else {
+        pf = next<Fn>.load();
+    }
+
+    if (pf == fn_not_implemented) {
         return false;
     }
 
     if constexpr (!Registry::has_n2216) {
-        if (next<Fn> == fn_ambiguous) {
+        if (pf == fn_ambiguous) {
             return false;
         }
     }
@@ -2573,6 +3599,142 @@ method<Id, ReturnType(Parameters...), Registry>::has_next() -> bool {
     return true;
 }
 
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<auto Old, auto New>
+auto method<Id, ReturnType(Parameters...), Registry>::replace() -> bool {
+    using namespace detail;
+
+    static_assert(
+        !Registry::has_lazy_dispatch && !Registry::has_position_independent,
+        "replace cannot be used with lazy_dispatch or position_independent");
+
+    using OldThunk = thunk<Old, decltype(Old)>;
+    using NewThunk = thunk<New, decltype(New)>;
+    static_assert(
+        std::is_same_v<
+            typename OldThunk::OverriderVirtualParameters,
+            typename NewThunk::OverriderVirtualParameters>,
+        "the overriders must have the same virtual parameter types");
+
+    auto old_pf = reinterpret_cast<void (*)()>(OldThunk::fn);
+    auto new_pf = reinterpret_cast<void (*)()>(NewThunk::fn);
+    void (*old_swapped)() = nullptr;
+    void (*new_swapped)() = nullptr;
+
+    if constexpr (symmetric_method<method>::value) {
+        using OldImpl = decltype(override_impl_of<Old>(Old));
+        using NewImpl = decltype(override_impl_of<New>(New));
+        old_swapped = reinterpret_cast<void (*)()>(OldImpl::swapped);
+        new_swapped = reinterpret_cast<void (*)()>(NewImpl::swapped);
+    }
+
+    overrider_info* spec = nullptr;
+
+    for (auto& candidate : fn.specs) {
+        if (candidate.pf == old_pf) {
+            spec = &candidate;
+        }
+    }
+
+    if (!spec) {
+        return false;
+    }
+
+    [[maybe_unused]] std::int32_t old_offset = 0, new_offset = 0;
+
+    if constexpr (Registry::has_compact_dispatch) {
+        // Validate before modifying anything.
+        auto offset = [](void (*pf)()) {
+            return std::intptr_t(
+                reinterpret_cast<std::uintptr_t>(pf) -
+                reinterpret_cast<std::uintptr_t>(&Registry::code_origin));
+        };
+
+        auto offset_of_new = offset(new_pf);
+
+        if (offset_of_new < INT32_MIN || offset_of_new > INT32_MAX) {
+            if constexpr (Registry::has_error_handler) {
+                code_offset_error error;
+                error.overrider = new_pf;
+                error.offset = offset_of_new;
+                Registry::error_handler::error(error);
+            }
+
+            abort();
+        }
+
+        old_offset = std::int32_t(offset(old_pf));
+        new_offset = std::int32_t(offset_of_new);
+    }
+
+    spec->next = reinterpret_cast<void (**)()>(&next<New>);
+    store_next(spec->next, reinterpret_cast<void (*)()>(next<Old>.load()));
+    spec->pf = new_pf;
+
+    if constexpr (symmetric_method<method>::value) {
+        spec->pf_swapped = new_swapped;
+    }
+
+    // Each pointer and cell is rewritten atomically: concurrent calls use
+    // either `Old` or `New`.
+    for (auto& other : fn.specs) {
+        if (*other.next == old_pf) {
+            store_next(other.next, new_pf);
+        } else if (old_swapped && *other.next == old_swapped) {
+            store_next(other.next, new_swapped);
+        }
+    }
+
+    // Overriders are code addresses, they cannot be confused with the indices
+    // and data addresses also stored in the dispatch data.
+    auto patch = [old_pf, new_pf, old_swapped, new_swapped](word& cell) {
+        if (cell.pf == old_pf) {
+            store_release(cell, new_pf);
+        } else if (old_swapped && cell.pf == old_swapped) {
+            store_release(cell, new_swapped);
+        }
+    };
+
+    auto& cells = fn.cells;
+    auto data = Registry::dispatch_data.data();
+    std::for_each(data + cells.table_begin, data + cells.table_end, patch);
+
+    if (cells.vtbl_cells) {
+        // The v-tables of the classes derived from the first virtual
+        // parameter contain cells, starting at the method's first slot.
+        auto slot = fn.slots_strides_data()[0];
+
+        for (auto& cls : Registry::classes) {
+            if (*cls.static_vptr &&
+                fallback_resolver<Registry>::is_base_of(
+                    *fn.vp_begin, cls.type)) {
+                auto vtbl = const_cast<word*>(*cls.static_vptr) + slot;
+                std::for_each(vtbl, vtbl + cells.vtbl_cells, patch);
+            }
+        }
+    }
+
+    if constexpr (Registry::has_compact_dispatch) {
+        auto compact = Registry::compact_dispatch_data.data();
+
+        for (auto cell = compact + cells.compact_begin;
+             cell != compact + cells.compact_end; ++cell) {
+            if (cell->load(std::memory_order_relaxed) == old_offset) {
+                cell->store(new_offset, std::memory_order_release);
+            }
+        }
+    }
+
+    if constexpr (Registry::has_interpreted_dispatch) {
+        // Invalidate the overriders cached by interpreted dispatch. The
+        // vptrs did not change, but they share the epoch.
+        ++Registry::epoch;
+    }
+
+    return true;
+}
+
 template<
     typename Id, typename... Parameters, typename ReturnType, class Registry>
 BOOST_NORETURN auto
@@ -2609,6 +3771,79 @@ method<Id, ReturnType(Parameters...), Registry>::fn_ambiguous(
     abort(); // in case user handler "forgets" to abort
 }
 
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+auto method<Id, ReturnType(Parameters...), Registry>::fn_lazy(
+    detail::remove_virtual_<Parameters>... args) -> ReturnType {
+    // The dispatch table has not been built yet. Build it, then retry.
+    Registry::build_method(fn);
+
+    return fn(std::forward<detail::remove_virtual_<Parameters>>(args)...);
+}
+
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+auto method<Id, ReturnType(Parameters...), Registry>::fn_interpreted(
+    detail::remove_virtual_<Parameters>... args) -> ReturnType {
+    using namespace detail;
+
+    vptr_type vptrs[Arity];
+    fn.template collect_vptrs<mp11::mp_list<Parameters...>>(vptrs, args...);
+
+    // The v-table entries for the first virtual argument point to the cells
+    // that precede the interpreter's data. The other entries contain the
+    // group numbers.
+    auto data = fn.interpreter_data;
+    std::size_t groups[Arity];
+    auto slots = fn.slots_strides_data();
+    groups[0] = vptrs[0][slots[0]].pw - (data - data[0].i);
+
+    for (std::size_t dim = 1; dim < Arity; ++dim) {
+        groups[dim] = vptrs[dim][slots[dim]].i;
+    }
+
+    constexpr auto cache_size =
+        Registry::template policy<policies::interpreted_dispatch>::cache_size;
+    void (*pf)();
+
+    if constexpr (cache_size != 0) {
+        static thread_local interpreted_cache<Arity, cache_size> cache;
+        pf = cache.find(Registry::epoch, groups);
+
+        if (!pf) {
+            pf = interpret<Registry, Arity>(fn, groups);
+            cache.insert(Registry::epoch, groups, pf);
+        }
+    } else {
+        pf = interpret<Registry, Arity>(fn, groups);
+    }
+
+    if constexpr (Registry::has_instrumentation) {
+        Registry::instrumentation::count(fn, pf);
+    }
+
+    return reinterpret_cast<FunctionPointer>(pf)(
+        std::forward<remove_virtual_<Parameters>>(args)...);
+}
+
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<typename MethodArgList, typename ArgType, typename... MoreArgTypes>
+void method<Id, ReturnType(Parameters...), Registry>::collect_vptrs(
+    vptr_type* vptrs, const ArgType& arg,
+    const MoreArgTypes&... more_args) const {
+    using namespace detail;
+    using namespace boost::mp11;
+
+    if constexpr (is_virtual<mp_first<MethodArgList>>::value) {
+        *vptrs++ = vptr<ArgType>(arg);
+    }
+
+    if constexpr (sizeof...(MoreArgTypes) != 0) {
+        collect_vptrs<mp_rest<MethodArgList>>(vptrs, more_args...);
+    }
+}
+
 // -----------------------------------------------------------------------------
 // overriders
 
@@ -2703,7 +3938,8 @@ template<
     typename Id, typename... Parameters, typename ReturnType, class Registry>
 template<auto Function, typename FnReturnType>
 method<Id, ReturnType(Parameters...), Registry>::override_impl<
-    Function, FnReturnType>::override_impl(FunctionPointer* p_next) {
+    Function, FnReturnType>::override_impl(
+    detail::next_ptr<FunctionPointer>* p_next) {
     using namespace detail;
 
     // static variable this->method below is zero-initialized but gcc and clang
@@ -2742,15 +3978,51 @@ method<Id, ReturnType(Parameters...), Registry>::override_impl<
     this->next = reinterpret_cast<void (**)()>(
         p_next ? p_next : &method::next<Function>);
 
+    if constexpr (Registry::has_fallback_dispatch) {
+        // Until the dispatch data is published, `next` resolves on the fly.
+        instance = this;
+        *this->next = reinterpret_cast<void (*)()>(fallback_next);
+    }
+
     using Thunk = thunk<Function, decltype(Function)>;
     this->pf = reinterpret_cast<void (*)()>(Thunk::fn);
 
+    if constexpr (symmetric_method<method>::value) {
+        this->pf_swapped = reinterpret_cast<void (*)()>(swapped);
+    }
+
     this->vp_begin = vp_type_ids;
     this->vp_end = vp_type_ids + Arity;
 
     fn.specs.push_back(*this);
 }
 
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<auto Function, typename FnReturnType>
+auto method<Id, ReturnType(Parameters...), Registry>::override_impl<
+    Function, FnReturnType>::
+    fallback_next(detail::remove_virtual_<Parameters>... args) -> ReturnType {
+    auto pf = detail::fallback_resolver<Registry>::template resolve<Arity>(
+        fn, instance->vp_begin, instance);
+
+    return reinterpret_cast<FunctionPointer>(pf)(
+        std::forward<detail::remove_virtual_<Parameters>>(args)...);
+}
+
+template<
+    typename Id, typename... Parameters, typename ReturnType, class Registry>
+template<auto Function, typename FnReturnType>
+auto method<Id, ReturnType(Parameters...), Registry>::override_impl<
+    Function,
+    FnReturnType>::swapped(detail::remove_virtual_<Parameters>... args)
+    -> ReturnType {
+    // Used when the overrider matches the virtual arguments in reverse order.
+    return call_swapped(
+        thunk<Function, decltype(Function)>::fn,
+        std::forward<detail::remove_virtual_<Parameters>>(args)...);
+}
+
 template<
     typename Id, typename... Parameters, typename ReturnType, class Registry>
 template<auto Function, typename FnReturnType>
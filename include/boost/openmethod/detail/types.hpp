@@ -6,7 +6,10 @@
 #ifndef BOOST_OPENMETHOD_DETAIL_TYPES_HPP
 #define BOOST_OPENMETHOD_DETAIL_TYPES_HPP
 
+#include <atomic>
 #include <cstdint>
+#include <utility>
+#include <vector>
 
 #include <boost/openmethod/detail/static_list.hpp>
 
@@ -37,6 +40,59 @@ union word {
     word* pw;
 };
 
+// Atomic access to the v-table entries that lazy_dispatch writes, and to the
+// cells that method::replace rewrites, while other threads may be reading
+// them.
+inline auto atomic_word(word& w) -> std::atomic<std::size_t>& {
+    static_assert(
+        sizeof(std::atomic<std::size_t>) == sizeof(word) &&
+            std::atomic<std::size_t>::is_always_lock_free,
+        "atomic_word requires lock-free, pointer-sized atomics");
+
+    return reinterpret_cast<std::atomic<std::size_t>&>(w.i);
+}
+
+inline auto load_acquire(const word& w) -> word {
+    return atomic_word(const_cast<word&>(w)).load(std::memory_order_acquire);
+}
+
+inline auto store_release(word& w, word value) -> void {
+    atomic_word(w).store(value.i, std::memory_order_release);
+}
+
+// Atomic access to the `next` pointers, which `initialize` and
+// method::replace may write while overriders are calling through them.
+inline auto store_next(void (**next)(), void (*pf)()) -> void {
+    store_release(*reinterpret_cast<word*>(next), pf);
+}
+
+template<typename FunctionPointer>
+inline auto load_next(const FunctionPointer& next) -> FunctionPointer {
+    static_assert(sizeof(FunctionPointer) == sizeof(word));
+
+    return reinterpret_cast<FunctionPointer>(
+        load_acquire(reinterpret_cast<const word&>(next)).pf);
+}
+
+// The type of `method::next<Fn>`. It contains only the pointer, which
+// `initialize` and `method::replace` write with `store_next`, thus it is read
+// atomically, including when the next overrider is called.
+template<typename FunctionPointer>
+struct next_ptr;
+
+template<typename ReturnType, typename... Args>
+struct next_ptr<ReturnType (*)(Args...)> {
+    ReturnType (*pf)(Args...);
+
+    auto load() const -> ReturnType (*)(Args...) {
+        return load_next(pf);
+    }
+
+    auto operator()(Args... args) const -> ReturnType {
+        return load()(std::forward<Args>(args)...);
+    }
+};
+
 #if defined(UINTPTR_MAX)
 using uintptr = std::uintptr_t;
 constexpr uintptr uintptr_max = UINTPTR_MAX;
@@ -52,6 +108,29 @@ constexpr uintptr uintptr_max = (std::numeric_limits<std::size_t>::max)();
 
 using vptr_type = const detail::word*;
 
+namespace detail {
+
+// Atomic access to the static v-table pointers, which `initialize` replaces
+// under deferred_reclamation while other threads may be reading them.
+inline auto load_acquire(const vptr_type& vptr) -> vptr_type {
+    static_assert(
+        sizeof(std::atomic<vptr_type>) == sizeof(vptr_type) &&
+            std::atomic<vptr_type>::is_always_lock_free,
+        "load_acquire requires lock-free, pointer-sized atomics");
+
+    return reinterpret_cast<const std::atomic<vptr_type>&>(vptr).load(
+        std::memory_order_acquire);
+}
+
+inline auto store_release(vptr_type& vptr, vptr_type value) -> void {
+    reinterpret_cast<std::atomic<vptr_type>&>(vptr).store(
+        value, std::memory_order_release);
+}
+
+} // namespace detail
+
+using vindex_type = std::uint32_t;
+
 using type_id = const void*;
 
 template<typename T>
@@ -187,6 +266,27 @@ struct static_slot_error : static_offset_error {};
 //! For future use
 struct static_stride_error : static_offset_error {};
 
+//! Overrider too far from the registry's code
+//!
+//! Compact dispatch tables store overriders as 32-bit offsets from a function
+//! of the registry. If an overrider lies farther than that, and if the registry
+//! contains an @ref error_handler policy, its @ref error function is called
+//! with a `code_offset_error` object, then the program is terminated with
+//! @ref abort.
+struct code_offset_error : openmethod_error {
+    //! The overrider.
+    void (*overrider)();
+    //! The offset of the overrider from the registry's code.
+    std::intptr_t offset;
+
+    //! Write a short description to an output stream
+    //! @param os The output stream
+    //! @tparam Registry The registry
+    //! @tparam Stream A @ref LightweightOutputStream
+    template<class Registry, class Stream>
+    auto write(Stream& os) const -> void;
+};
+
 namespace detail {
 
 struct empty {};
@@ -213,6 +313,7 @@ struct range {
 struct class_info : static_list<class_info>::static_link {
     type_id type;
     vptr_type* static_vptr;
+    vindex_type* static_vindex;
     type_id *first_base, *last_base;
     bool is_abstract{false};
 
@@ -238,15 +339,33 @@ struct deferred_class_info : class_info {
 
 struct overrider_info;
 
+// The cells of the dispatch data that contain the overriders of a method, as
+// offsets, recorded by `initialize` for `method::replace`. The cells in the
+// v-tables are found from the classes, on demand.
+struct dispatch_cells {
+    std::size_t table_begin = 0, table_end = 0;     // in dispatch_data
+    std::size_t compact_begin = 0, compact_end = 0; // in compact_dispatch_data
+    std::size_t vtbl_cells = 0; // per v-table, from the method's first slot
+};
+
 struct method_info : static_list<method_info>::static_link {
     type_id* vp_begin;
     type_id* vp_end;
     static_list<overrider_info> specs;
     void (*not_implemented)();
     void (*ambiguous)();
+    void (*lazy_resolver)();
+    void (*interpreter)();
+    const word* interpreter_data;
+    bool interpreted;
+    bool symmetric;
+    const word* symmetric_table;
+    bool inline_row; // dispatch table row stored in the v-tables
     type_id method_type_id;
     type_id return_type_id;
     std::size_t* slots_strides_ptr;
+    std::size_t index; // in the generations, under deferred_reclamation
+    dispatch_cells cells;
 
     auto arity() const {
         return std::distance(vp_begin, vp_end);
@@ -268,6 +387,7 @@ struct overrider_info : static_list<overrider_info>::static_link {
     void (**next)();
     type_id *vp_begin, *vp_end;
     void (*pf)();
+    void (*pf_swapped)(); // for symmetric methods
 };
 
 struct deferred_overrider_info : overrider_info {
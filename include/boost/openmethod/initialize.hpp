@@ -11,11 +11,16 @@
 #include <boost/openmethod/detail/trace.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <climits>
 #include <cstdint>
 #include <deque>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -59,6 +64,14 @@ struct aggregate_reports<mp11::mp_list<Reports...>, mp11::mp_list<>, Void> {
     struct type : Reports... {};
 };
 
+// `true` if the dispatch_memory policy rounds the blocks to huge pages.
+template<class Memory, typename = void>
+struct has_huge_pages_aux : std::false_type {};
+
+template<class Memory>
+struct has_huge_pages_aux<Memory, std::void_t<decltype(Memory::huge_pages)>>
+    : std::bool_constant<Memory::huge_pages> {};
+
 inline void merge_into(boost::dynamic_bitset<>& a, boost::dynamic_bitset<>& b) {
     if (b.size() < a.size()) {
         b.resize(a.size());
@@ -90,6 +103,13 @@ struct generic_compiler {
 
     struct vtbl_entry {
         std::size_t method_index, vp_index, group_index;
+        std::size_t column = 0; // in a row stored in the v-table
+
+        auto operator==(const vtbl_entry& other) const -> bool {
+            return method_index == other.method_index &&
+                vp_index == other.vp_index &&
+                group_index == other.group_index && column == other.column;
+        }
     };
 
     struct class_ {
@@ -106,6 +126,7 @@ struct generic_compiler {
         std::size_t mark = 0; // temporary mark to detect cycles
         std::vector<vtbl_entry> vtbl;
         vptr_type* static_vptr;
+        vindex_type* static_vindex;
 
         auto is_base_of(class_* other) const -> bool {
             return transitive_derived.find(other) != transitive_derived.end();
@@ -131,6 +152,7 @@ struct generic_compiler {
         class_* covariant_return_type = nullptr;
         void (*pf)();
         std::size_t method_index, spec_index;
+        bool mirrored = false; // symmetric method, virtual arguments swapped
     };
 
     using bitvec = boost::dynamic_bitset<>;
@@ -146,9 +168,16 @@ struct generic_compiler {
         std::size_t cells = 0;
         std::size_t not_implemented = 0;
         std::size_t ambiguous = 0;
+        std::size_t interpreted = 0;
+        std::size_t bytes_saved = 0;
+        std::size_t abstract_groups = 0;
+        std::size_t padding = 0; // cells added by power_of_two_strides
+        std::size_t inline_rows = 0;
     };
 
-    struct report : method_report {};
+    struct report : method_report {
+        std::size_t unique_vtables = 0;
+    };
 
     static void accumulate(const method_report& partial, report& total);
 
@@ -159,12 +188,23 @@ struct generic_compiler {
         std::vector<overrider> specs;
         std::vector<std::size_t> slots;
         std::vector<std::size_t> strides;
+        std::size_t first_stride = 1; // folded in the v-table entries
         std::vector<const overrider*> dispatch_table;
         // following two are dummies, when converting to a function pointer, we will
         // get the corresponding pointer from method_info
         overrider not_implemented;
         overrider ambiguous;
+        overrider lazy; // stands for all the cells of an unbuilt method
+        bool built = false;
+        bool interpreted = false;
+        bool symmetric = false;
+        std::vector<std::vector<bitvec>> group_masks; // by dimension and group
+        std::vector<const overrider*> interpreted_order;
         vptr_type gv_dispatch_table = nullptr;
+        vptr_type gv_interpreter_data = nullptr;
+        const std::atomic<std::int32_t>* gv_compact_table = nullptr;
+        std::size_t row_size = 0; // if the rows are stored in the v-tables
+        detail::dispatch_cells cells;
         auto arity() const {
             return vp.size();
         }
@@ -235,6 +275,8 @@ auto operator<<(trace_type<Registry>& trace, const spec_name& sn)
         trace << "not implemented";
     } else if (sn.def == &sn.method.ambiguous) {
         trace << "ambiguous";
+    } else if (sn.def == &sn.method.lazy) {
+        trace << "lazy";
     } else {
         trace << type_name(sn.def->info->type);
     }
@@ -253,10 +295,13 @@ struct registry<Policies...>::compiler : detail::generic_compiler {
 
     std::unordered_map<type_index_type, class_*> class_map;
 
+    // The first word of the dispatch data under position_independent.
+    static constexpr std::size_t image_magic = 0x4f4d4944; // "OMID"
+
     compiler();
 
     auto compile();
-    auto initialize();
+    auto initialize() -> compiler&;
     void install_global_tables();
 
     void augment_classes();
@@ -267,11 +312,48 @@ struct registry<Policies...>::compiler : detail::generic_compiler {
     void assign_tree_slots(class_& cls, std::size_t base_slot);
     void assign_lattice_slots(class_& cls);
     void build_dispatch_tables();
+    void build_method_tables(method& m);
+    void reorder_dimensions(method& m, const std::vector<group_map>& groups);
+    void pad_strides(method& m, const std::vector<group_map>& groups);
+    void prepare_inline_rows(method& m, const std::vector<group_map>& groups);
+    void allocate_inline_rows();
+    static auto vtbl_group(const method& m, const vtbl_entry& entry)
+        -> std::size_t;
+    void drop_abstract_groups(method& m, std::vector<group_map>& groups);
+    void add_mirrored_overriders(method& m);
+    void fold_symmetric_table(method& m, const std::vector<group_map>& groups);
+    void prepare_interpreted_method(
+        method& m, const std::vector<group_map>& groups, std::size_t cells);
+    static auto interpreted_size(const method& m) -> std::size_t;
+    static auto write_interpreted_data(const method& m, detail::word* first)
+        -> const detail::word*;
+    void reserve_lazy_method(method& m);
+    void install_lazy_method(method& m);
+    static void build_lazy_method(detail::method_info& info);
+    static auto lazy_instance() -> std::unique_ptr<compiler>&;
+    static auto lazy_mutex() -> std::mutex&;
     void build_dispatch_table(
         method& m, std::size_t dim,
         std::vector<group_map>::const_iterator group, const bitvec& candidates,
         bool concrete);
     void write_global_data();
+    auto share_vtables(const std::vector<std::size_t>& layout)
+        -> std::vector<std::size_t>;
+    template<class Range, class Heat>
+    static auto hot_first(const Range& range, Heat heat)
+        -> std::vector<std::size_t>;
+    static auto class_heat(const class_& cls) -> std::size_t;
+    static auto method_heat(const method& m) -> std::size_t;
+    static auto profile_key(type_id type) -> std::string;
+    void sort_groups_by_heat(method& m, const std::vector<group_map>& groups);
+    static auto is_compact(const method& m) -> bool;
+    static auto compact_cell(void (*pf)()) -> std::int32_t;
+    static auto code_cell(void (*pf)()) -> detail::word;
+    auto dispatch_fingerprint(
+        const std::vector<std::size_t>& table_offsets,
+        const std::vector<std::size_t>& vtbl_offsets,
+        const std::vector<std::size_t>& vtbl_owners, std::size_t size) const
+        -> std::size_t;
     void print(const method_report& report) const;
     static void select_dominant_overriders(
         std::vector<overrider*>& dominants, std::size_t& pick,
@@ -280,6 +362,9 @@ struct registry<Policies...>::compiler : detail::generic_compiler {
     is_more_specific(const overrider* a, const overrider* b) -> bool;
     static auto is_base(const overrider* a, const overrider* b) -> bool;
 
+    // Storage for the dispatch tables built on demand, see lazy_dispatch.
+    std::deque<dispatch_vector<detail::word>> lazy_tables;
+
     mutable detail::trace_type<registry> trace;
     using indent = typename detail::trace_type<registry>::indent;
 };
@@ -293,6 +378,8 @@ void registry<Policies...>::compiler::install_global_tables() {
     write_global_data();
 
     print(report);
+    ++trace << report.unique_vtables << " unique v-tables for "
+            << classes.size() << " classes\n";
     ++trace << "Finished\n";
 }
 
@@ -309,11 +396,12 @@ auto registry<Policies...>::compiler::compile() {
 }
 
 template<class... Policies>
-auto registry<Policies...>::compiler::initialize() {
+auto registry<Policies...>::compiler::initialize() -> compiler& {
     compile();
     install_global_tables();
 
     registry<Policies...>::initialized = true;
+    ++registry<Policies...>::epoch;
 
     return *this;
 }
@@ -365,6 +453,7 @@ void registry<Policies...>::compiler::augment_classes() {
                 rtc = &classes.emplace_back();
                 rtc->is_abstract = cr.is_abstract;
                 rtc->static_vptr = cr.static_vptr;
+                rtc->static_vindex = cr.static_vindex;
             }
 
             if (std::find(
@@ -375,6 +464,23 @@ void registry<Policies...>::compiler::augment_classes() {
         }
     }
 
+    // Assign dense indexes to the classes seen for the first time. Classes
+    // that already have one keep it, so objects that store an index remain
+    // valid across calls to initialize().
+    {
+        vindex_type last_vindex = 0;
+
+        for (auto& rtc : classes) {
+            last_vindex = (std::max)(last_vindex, *rtc.static_vindex);
+        }
+
+        for (auto& rtc : classes) {
+            if (*rtc.static_vindex == 0) {
+                *rtc.static_vindex = ++last_vindex;
+            }
+        }
+    }
+
     // All known classes now have exactly one associated class_* in the
     // map. Collect the bases.
 
@@ -632,6 +738,10 @@ void registry<Policies...>::compiler::augment_methods() {
             ++spec_iter;
         }
 
+        if (meth_info.symmetric) {
+            add_mirrored_overriders(*meth_iter);
+        }
+
         ++meth_iter;
     }
 
@@ -790,332 +900,1309 @@ void registry<Policies...>::compiler::assign_lattice_slots(class_& cls) {
 
 template<class... Policies>
 void registry<Policies...>::compiler::build_dispatch_tables() {
+    for (auto& m : methods) {
+        if constexpr (has_lazy_dispatch) {
+            if (m.symmetric) {
+                build_method_tables(m);
+                m.built = true;
+            } else {
+                reserve_lazy_method(m);
+            }
+        } else {
+            build_method_tables(m);
+        }
+    }
+
+    if constexpr (has_inline_rows) {
+        allocate_inline_rows();
+    }
+}
+
+template<class... Policies>
+void registry<Policies...>::compiler::build_method_tables(method& m) {
     using namespace detail;
 
-    for (auto& m : methods) {
-        ++trace << "Building dispatch table for "
-                << type_name(m.info->method_type_id) << "\n";
-        indent _(trace);
+    ++trace << "Building dispatch table for "
+            << type_name(m.info->method_type_id) << "\n";
+    indent _(trace);
 
-        auto dims = m.arity();
+    auto dims = m.arity();
 
-        std::vector<group_map> groups;
-        groups.resize(dims);
+    std::vector<group_map> groups;
+    groups.resize(dims);
 
-        {
-            std::size_t dim = 0;
+    {
+        std::size_t dim = 0;
 
-            for (auto vp : m.vp) {
-                auto& dim_group = groups[dim];
-                ++trace << "make groups for param #" << dim << ", class " << *vp
-                        << "\n";
-                indent _(trace);
+        for (auto vp : m.vp) {
+            auto& dim_group = groups[dim];
+            ++trace << "make groups for param #" << dim << ", class " << *vp
+                    << "\n";
+            indent _(trace);
 
-                for (auto covariant_class : vp->transitive_derived) {
-                    ++trace << "specs applicable to " << *covariant_class
-                            << "\n";
-                    bitvec mask;
-                    mask.resize(m.specs.size());
-
-                    std::size_t group_index = 0;
-                    indent _2(trace);
-
-                    for (auto& spec : m.specs) {
-                        if (spec.vp[dim]->transitive_derived.find(
-                                covariant_class) !=
-                            spec.vp[dim]->transitive_derived.end()) {
-                            ++trace << type_name(spec.info->type) << "\n";
-                            mask[group_index] = 1;
-                        }
-                        ++group_index;
-                    }
+            for (auto covariant_class : vp->transitive_derived) {
+                ++trace << "specs applicable to " << *covariant_class
+                        << "\n";
+                bitvec mask;
+                mask.resize(m.specs.size());
 
-                    auto& group = dim_group[mask];
-                    group.classes.push_back(covariant_class);
-                    group.has_concrete_classes = group.has_concrete_classes ||
-                        !covariant_class->is_abstract;
+                std::size_t group_index = 0;
+                indent _2(trace);
 
-                    ++trace << "-> mask: " << mask << "\n";
+                for (auto& spec : m.specs) {
+                    if (spec.vp[dim]->transitive_derived.find(
+                            covariant_class) !=
+                        spec.vp[dim]->transitive_derived.end()) {
+                        ++trace << type_name(spec.info->type) << "\n";
+                        mask[group_index] = 1;
+                    }
+                    ++group_index;
                 }
 
-                ++dim;
+                auto& group = dim_group[mask];
+                group.classes.push_back(covariant_class);
+                group.has_concrete_classes = group.has_concrete_classes ||
+                    !covariant_class->is_abstract;
+
+                ++trace << "-> mask: " << mask << "\n";
             }
+
+            ++dim;
         }
+    }
 
-        {
-            std::size_t stride = 1;
-            m.strides.reserve(dims - 1);
+    if constexpr (has_drop_abstract_groups) {
+        drop_abstract_groups(m, groups);
+    }
 
-            for (std::size_t dim = 1; dim < m.arity(); ++dim) {
-                stride *= groups[dim - 1].size();
-                ++trace << "    stride for dim " << dim << " = " << stride
-                        << "\n";
-                m.strides.push_back(stride);
-            }
+    {
+        std::size_t stride = 1;
+        m.strides.reserve(dims - 1);
+
+        for (std::size_t dim = 1; dim < m.arity(); ++dim) {
+            stride *= groups[dim - 1].size();
+            ++trace << "    stride for dim " << dim << " = " << stride
+                    << "\n";
+            m.strides.push_back(stride);
         }
+    }
+
+    for (std::size_t dim = 0; dim < m.arity(); ++dim) {
+        indent _(trace);
+        std::size_t group_num = 0;
 
-        for (std::size_t dim = 0; dim < m.arity(); ++dim) {
+        for (auto& [mask, group] : groups[dim]) {
+            ++trace << "groups for dim " << dim << ":\n";
             indent _(trace);
-            std::size_t group_num = 0;
+            ++trace << group_num << " mask " << mask << ":\n";
 
-            for (auto& [mask, group] : groups[dim]) {
-                ++trace << "groups for dim " << dim << ":\n";
+            for (auto cls : group.classes) {
                 indent _(trace);
-                ++trace << group_num << " mask " << mask << ":\n";
+                ++trace << type_name(cls->type_ids[0]) << "\n";
+                auto& entry = cls->vtbl[m.slots[dim] - cls->first_slot];
+                entry.method_index = &m - &methods[0];
+                entry.vp_index = dim;
+                entry.group_index = group_num;
+            }
 
-                for (auto cls : group.classes) {
-                    indent _(trace);
-                    ++trace << type_name(cls->type_ids[0]) << "\n";
-                    auto& entry = cls->vtbl[m.slots[dim] - cls->first_slot];
-                    entry.method_index = &m - &methods[0];
-                    entry.vp_index = dim;
-                    entry.group_index = group_num;
-                }
+            ++group_num;
+        }
+    }
+
+    if constexpr (has_interpreted_dispatch) {
+        if (dims > 1 && !m.symmetric) {
+            using options = policy<policies::interpreted_dispatch>;
+            std::size_t cells = 1;
 
-                ++group_num;
+            for (const auto& dim_groups : groups) {
+                cells *= dim_groups.size();
+            }
+
+            if (m.info->interpreted ||
+                (options::max_cells != 0 && cells > options::max_cells)) {
+                prepare_interpreted_method(m, groups, cells);
+                print(m.report);
+                accumulate(m.report, report);
+
+                return;
             }
         }
+    }
 
-        {
-            ++trace << "building dispatch table\n";
-            bitvec all(m.specs.size());
-            all = ~all;
-            build_dispatch_table(m, dims - 1, groups.end() - 1, all, true);
+    {
+        ++trace << "building dispatch table\n";
+        bitvec all(m.specs.size());
+        all = ~all;
+        build_dispatch_table(m, dims - 1, groups.end() - 1, all, true);
+
+        if constexpr (has_profile_guided_layout) {
+            if (dims > 1 && !m.symmetric) {
+                sort_groups_by_heat(m, groups);
+            }
+        }
 
-            if (m.arity() > 1) {
-                indent _(trace);
-                m.report.cells = 1;
-                ++trace << "dispatch table rank: ";
-                const char* prefix = "";
-
-                for (const auto& dim_groups : groups) {
-                    m.report.cells *= dim_groups.size();
-                    trace << prefix << dim_groups.size();
-                    prefix = " x ";
+        if (m.symmetric) {
+            fold_symmetric_table(m, groups);
+        } else if (dims > 1) {
+            if constexpr (has_inline_rows) {
+                using options = policy<policies::inline_rows>;
+
+                if (dims == 2 && groups[1].size() <= options::max_row) {
+                    prepare_inline_rows(m, groups);
                 }
+            }
 
-                prefix = ", concrete only: ";
+            if (!m.row_size) {
+                if constexpr (has_reorder_dimensions) {
+                    reorder_dimensions(m, groups);
+                }
 
-                for (const auto& dim_groups : groups) {
-                    auto cells = std::count_if(
-                        dim_groups.begin(), dim_groups.end(),
-                        [](const auto& group) {
-                            return group.second.has_concrete_classes;
-                        });
-                    trace << prefix << cells;
-                    prefix = " x ";
+                if constexpr (has_power_of_two_strides) {
+                    pad_strides(m, groups);
                 }
+            }
+        }
 
-                trace << "\n";
+        if (m.arity() > 1) {
+            indent _(trace);
+            m.report.cells = 1;
+            ++trace << "dispatch table rank: ";
+            const char* prefix = "";
+
+            for (const auto& dim_groups : groups) {
+                m.report.cells *= dim_groups.size();
+                trace << prefix << dim_groups.size();
+                prefix = " x ";
+            }
+
+            if (m.symmetric) {
+                m.report.cells = m.dispatch_table.size();
+                trace << ", triangular";
+            }
+
+            prefix = ", concrete only: ";
+
+            for (const auto& dim_groups : groups) {
+                auto cells = std::count_if(
+                    dim_groups.begin(), dim_groups.end(),
+                    [](const auto& group) {
+                        return group.second.has_concrete_classes;
+                    });
+                trace << prefix << cells;
+                prefix = " x ";
             }
 
-            print(m.report);
-            accumulate(m.report, report);
+            trace << "\n";
         }
+
+        print(m.report);
+        accumulate(m.report, report);
     }
 }
 
 template<class... Policies>
-void registry<Policies...>::compiler::build_dispatch_table(
-    method& m, std::size_t dim,
-    std::vector<group_map>::const_iterator group_iter, const bitvec& candidates,
-    bool concrete) {
-    using namespace detail;
+void registry<Policies...>::compiler::drop_abstract_groups(
+    method& m, std::vector<group_map>& groups) {
+    // Once constructed, objects never have an abstract dynamic type, so the
+    // cells of a group that contains only abstract classes are reached only
+    // from constructors and destructors. Move these classes to the group
+    // without applicable overriders, which resolves to not_implemented. If
+    // there is no such group, create it, provided that it replaces at least
+    // two groups; otherwise, it would not save a row.
+    for (std::size_t dim = 0; dim < m.arity(); ++dim) {
+        auto& dim_groups = groups[dim];
+        bitvec none(m.specs.size());
+        auto has_empty_group = dim_groups.find(none) != dim_groups.end();
+        std::size_t abstract_groups = std::count_if(
+            dim_groups.begin(), dim_groups.end(), [](auto& entry) {
+                return entry.first.any() && !entry.second.has_concrete_classes;
+            });
 
-    indent _(trace);
-    std::size_t group_index = 0;
+        if (abstract_groups == 0 || (!has_empty_group && abstract_groups < 2)) {
+            continue;
+        }
 
-    for (const auto& [group_mask, group] : *group_iter) {
-        auto mask = candidates & group_mask;
+        auto& empty_classes = dim_groups[none].classes;
+        auto moved = empty_classes.size();
 
-        if constexpr (has_trace) {
-            ++trace << "group " << dim << "/" << group_index << " mask " << mask
-                    << "\n";
-            indent _(trace);
-            for (auto cls : range{group.classes.begin(), group.classes.end()}) {
-                ++trace << type_name(cls->type_ids[0]) << "\n";
+        for (auto iter = dim_groups.begin(); iter != dim_groups.end();) {
+            if (iter->first.none() || iter->second.has_concrete_classes) {
+                ++iter;
+                continue;
             }
+
+            auto& classes = iter->second.classes;
+            empty_classes.insert(
+                empty_classes.end(), classes.begin(), classes.end());
+            iter = dim_groups.erase(iter);
         }
 
-        if (dim == 0) {
-            std::vector<overrider*> overriders;
-            std::size_t i = 0;
+        // The rows saved.
+        m.report.abstract_groups += has_empty_group ? abstract_groups
+                                                    : abstract_groups - 1;
 
-            for (auto& spec : m.specs) {
-                if (mask[i]) {
-                    overriders.push_back(&spec);
-                }
-                ++i;
-            }
+        ++trace << "dim " << dim << ": " << empty_classes.size() - moved
+                << " abstract classes moved to the empty group\n";
+    }
+}
 
-            if constexpr (has_trace) {
-                ++trace << "select best of:\n";
-                indent _(trace);
+template<class... Policies>
+void registry<Policies...>::compiler::reorder_dimensions(
+    method& m, const std::vector<group_map>& groups) {
+    auto dims = m.arity();
+    std::vector<std::size_t> sizes, order(dims), strides(dims);
 
-                for (auto& app : overriders) {
-                    ++trace << "#" << app->spec_index << " "
-                            << type_name(app->info->type) << "\n";
-                }
-            }
+    for (const auto& dim_groups : groups) {
+        sizes.push_back(dim_groups.size());
+    }
 
-            std::vector<overrider*> dominants = overriders;
-            std::size_t pick, remaining;
+    // The largest dimension comes first. Ties are resolved by declaration
+    // order, to keep the layout reproducible.
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sizes](auto a, auto b) {
+        return sizes[a] > sizes[b];
+    });
 
-            select_dominant_overriders(dominants, pick, remaining);
+    ++trace << "dimension order:";
+    std::size_t stride = 1;
 
-            if (remaining == 0) {
-                indent _(trace);
-                ++trace << "not implemented\n";
-                m.dispatch_table.push_back(&m.not_implemented);
-                ++m.report.not_implemented;
-            } else {
-                if constexpr (!has_n2216) {
-                    if (remaining > 1) {
-                        ++trace << "ambiguous\n";
-                        m.dispatch_table.push_back(&m.ambiguous);
-                        ++m.report.ambiguous;
-                        continue;
-                    }
-                }
+    for (auto dim : order) {
+        trace << " " << dim;
+        strides[dim] = stride;
+        stride *= sizes[dim];
+    }
 
-                auto overrider = dominants[pick];
-                m.dispatch_table.push_back(overrider);
-                ++trace;
+    trace << "\n";
 
-                trace << "-> #" << overrider->spec_index << " "
-                      << type_name(overrider->info->type)
-                      << " pf = " << overrider->info->pf;
+    // The cells were built in declaration order, with the first dimension
+    // varying fastest.
+    std::vector<const overrider*> table(m.dispatch_table.size());
+    std::vector<std::size_t> index(dims, 0);
 
-                if (remaining > 1) {
-                    trace << " (ambiguous)";
-                    ++m.report.ambiguous;
-                }
+    for (auto cell : m.dispatch_table) {
+        std::size_t target = 0;
 
-                trace << "\n";
+        for (std::size_t dim = 0; dim < dims; ++dim) {
+            target += index[dim] * strides[dim];
+        }
 
-                // -------------------------------------------------------------
-                // next
+        table[target] = cell;
 
-                // First remove the dominant overriders from the overriders.
-                // Note that the dominants appear in the overriders in the same
-                // relative order.
-                auto candidate = overriders.begin();
-                remaining = 0;
+        for (std::size_t dim = 0; dim < dims && ++index[dim] == sizes[dim];
+             ++dim) {
+            index[dim] = 0;
+        }
+    }
 
-                for (auto dominant : dominants) {
-                    if (*candidate == dominant) {
-                        *candidate = nullptr;
-                    } else {
-                        ++remaining;
-                    }
+    m.dispatch_table.swap(table);
+    m.first_stride = strides[0];
+    m.strides.assign(strides.begin() + 1, strides.end());
+}
 
-                    ++candidate;
-                }
+template<class... Policies>
+void registry<Policies...>::compiler::sort_groups_by_heat(
+    method& m, const std::vector<group_map>& groups) {
+    auto dims = m.arity();
+    std::vector<std::size_t> sizes, strides;
+    std::vector<std::vector<std::size_t>> ranks(dims);
+    std::size_t stride = 1;
+
+    // Renumber the groups of each dimension, hottest first.
+    for (std::size_t dim = 0; dim < dims; ++dim) {
+        std::vector<std::size_t> heats;
+
+        for (auto& [mask, group] : groups[dim]) {
+            std::size_t heat = 0;
+
+            for (auto cls : group.classes) {
+                heat += class_heat(*cls);
+            }
 
-                if (remaining == 0) {
-                    ++trace << "no 'next'\n";
-                    overrider->next = &m.not_implemented;
-                } else {
-                    if constexpr (has_trace) {
-                        ++trace << "for 'next', select best of:\n";
-                        indent _(trace);
+            heats.push_back(heat);
+        }
 
-                        for (auto& app : overriders) {
-                            if (app) {
-                                ++trace << "#" << app->spec_index << " "
-                                        << type_name(app->info->type) << "\n";
-                            }
-                        }
-                    }
+        auto order = hot_first(heats, [](std::size_t heat) { return heat; });
+        ranks[dim].resize(order.size());
 
-                    select_dominant_overriders(overriders, pick, remaining);
+        for (std::size_t rank = 0; rank < order.size(); ++rank) {
+            ranks[dim][order[rank]] = rank;
+        }
 
-                    if constexpr (!has_n2216) {
-                        if (remaining > 1) {
-                            ++trace << "ambiguous 'next'\n";
-                            overrider->next = &m.ambiguous;
-                            continue;
-                        }
-                    }
+        for (auto& [mask, group] : groups[dim]) {
+            for (auto cls : group.classes) {
+                auto& entry = cls->vtbl[m.slots[dim] - cls->first_slot];
+                entry.group_index = ranks[dim][entry.group_index];
+            }
+        }
 
-                    auto next_overrider = overriders[pick];
-                    overrider->next = next_overrider;
+        sizes.push_back(order.size());
+        strides.push_back(stride);
+        stride *= order.size();
+    }
 
-                    ++trace << "-> #" << next_overrider->spec_index << " "
-                            << type_name(next_overrider->info->type)
-                            << " pf = " << next_overrider->info->pf;
+    std::vector<const overrider*> table(m.dispatch_table.size());
+    std::vector<std::size_t> index(dims, 0);
 
-                    if (remaining > 1) {
-                        trace << " (ambiguous)";
-                        // do not increment m.report.ambiguous, for same reason
-                    }
+    for (auto cell : m.dispatch_table) {
+        std::size_t target = 0;
 
-                    trace << "\n";
-                }
-            }
-        } else {
-            build_dispatch_table(
-                m, dim - 1, group_iter - 1, mask,
-                concrete && group.has_concrete_classes);
+        for (std::size_t dim = 0; dim < dims; ++dim) {
+            target += ranks[dim][index[dim]] * strides[dim];
         }
 
-        ++group_index;
+        table[target] = cell;
+
+        for (std::size_t dim = 0; dim < dims && ++index[dim] == sizes[dim];
+             ++dim) {
+            index[dim] = 0;
+        }
     }
-}
 
-inline void detail::generic_compiler::accumulate(
-    const method_report& partial, report& total) {
-    total.cells += partial.cells;
-    total.not_implemented += partial.not_implemented != 0;
-    total.ambiguous += partial.ambiguous != 0;
+    m.dispatch_table.swap(table);
 }
 
 template<class... Policies>
-void registry<Policies...>::compiler::write_global_data() {
-    using namespace policies;
-    using namespace detail;
+void registry<Policies...>::compiler::pad_strides(
+    method& m, const std::vector<group_map>& groups) {
+    auto dims = m.arity();
+    std::vector<std::size_t> sizes, strides, order(dims), padded(dims);
 
-    auto dispatch_data_size = std::accumulate(
-        methods.begin(), methods.end(), std::size_t(0),
-        [](auto sum, auto& m) { return sum + m.dispatch_table.size(); });
-    dispatch_data_size = std::accumulate(
-        classes.begin(), classes.end(), dispatch_data_size,
-        [](auto sum, auto& cls) { return sum + cls.vtbl.size(); });
+    for (const auto& dim_groups : groups) {
+        sizes.push_back(dim_groups.size());
+    }
 
-    dispatch_data.resize(dispatch_data_size);
-    auto gv_first = dispatch_data.data();
-    [[maybe_unused]] auto gv_last = gv_first + dispatch_data.size();
-    auto gv_iter = gv_first;
+    strides.push_back(m.first_stride);
+    strides.insert(strides.end(), m.strides.begin(), m.strides.end());
 
-    ++trace << "Initializing multi-method dispatch tables at " << gv_iter
-            << "\n";
+    // Round up the size of each dimension, except the one with the largest
+    // stride, to a power of two. Thus all the strides are powers of two.
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&strides](auto a, auto b) {
+        return strides[a] < strides[b];
+    });
 
-    for (auto& m : methods) {
-        if (m.info->arity() == 1) {
-            // Uni-methods just need an index in the method table.
-            m.info->slots_strides_ptr[0] = m.slots[0];
-        } else {
-            auto strides_iter = std::copy(
-                m.slots.begin(), m.slots.end(), m.info->slots_strides_ptr);
-            std::copy(m.strides.begin(), m.strides.end(), strides_iter);
+    std::size_t stride = 1;
 
-            if constexpr (has_trace) {
-                ++trace << rflush(4, dispatch_data.size()) << " " << " method #"
-                        << m.dispatch_table[0]->method_index << " "
-                        << type_name(m.info->method_type_id) << "\n";
-                indent _(trace);
+    for (std::size_t i = 0; i < dims; ++i) {
+        auto dim = order[i];
+        padded[dim] = stride;
+        auto size = sizes[dim];
 
-                for (auto& entry : m.dispatch_table) {
-                    ++trace << "spec #" << entry->spec_index << " "
-                            << spec_name(m, entry) << "\n";
-                }
+        if (i + 1 < dims) {
+            size = 1;
+
+            while (size < sizes[dim]) {
+                size *= 2;
             }
+        }
 
+        stride *= size;
+    }
+
+    // The padding cells are never reached.
+    std::vector<const overrider*> table(stride, &m.not_implemented);
+    std::vector<std::size_t> index(dims, 0);
+
+    for (std::size_t cell = 0; cell < m.dispatch_table.size(); ++cell) {
+        std::size_t source = 0, target = 0;
+
+        for (std::size_t dim = 0; dim < dims; ++dim) {
+            source += index[dim] * strides[dim];
+            target += index[dim] * padded[dim];
+        }
+
+        table[target] = m.dispatch_table[source];
+
+        for (std::size_t dim = 0; dim < dims && ++index[dim] == sizes[dim];
+             ++dim) {
+            index[dim] = 0;
+        }
+    }
+
+    m.report.padding = table.size() - m.dispatch_table.size();
+    ++trace << "padded to " << table.size() << " cells\n";
+    m.dispatch_table.swap(table);
+    m.first_stride = padded[0];
+    m.strides.clear();
+
+    // The strides of the other dimensions are stored as shifts.
+    for (std::size_t dim = 1; dim < dims; ++dim) {
+        std::size_t shift = 0;
+
+        while ((std::size_t(1) << shift) < padded[dim]) {
+            ++shift;
+        }
+
+        m.strides.push_back(shift);
+    }
+}
+
+template<class... Policies>
+void registry<Policies...>::compiler::prepare_inline_rows(
+    method& m, const std::vector<group_map>& groups) {
+    // Transpose the table, so that the cells for a group of the first
+    // argument are contiguous.
+    auto rows = groups[0].size(), row_size = groups[1].size();
+    std::vector<const overrider*> table(m.dispatch_table.size());
+
+    for (std::size_t row = 0; row < rows; ++row) {
+        for (std::size_t column = 0; column < row_size; ++column) {
+            table[row * row_size + column] =
+                m.dispatch_table[row + column * rows];
+        }
+    }
+
+    m.dispatch_table.swap(table);
+    m.row_size = row_size;
+    m.first_stride = row_size;
+    m.strides.assign(1, has_power_of_two_strides ? 0 : 1);
+    m.report.inline_rows = 1;
+    ++trace << "rows of " << row_size << " cells stored in v-tables\n";
+}
+
+template<class... Policies>
+void registry<Policies...>::compiler::allocate_inline_rows() {
+    using namespace detail;
+
+    // The rows go after all the other slots of the classes of the first
+    // parameter. The original slot is kept, and filled with the first cell.
+    for (auto& m : methods) {
+        if (!m.row_size) {
+            continue;
+        }
+
+        auto& classes = m.vp[0]->transitive_derived;
+        std::size_t base = 0;
+
+        for (auto cls : classes) {
+            base = (std::max)(base, cls->first_slot + cls->vtbl.size());
+        }
+
+        ++trace << type_name(m.info->method_type_id) << ": rows at slot "
+                << base << "\n";
+
+        for (auto cls : classes) {
+            auto entry = cls->vtbl[m.slots[0] - cls->first_slot];
+            cls->vtbl.resize(base + m.row_size - cls->first_slot, entry);
+
+            for (std::size_t column = 0; column < m.row_size; ++column) {
+                entry.column = column;
+                cls->vtbl[base + column - cls->first_slot] = entry;
+            }
+        }
+
+        m.slots[0] = base;
+    }
+}
+
+template<class... Policies>
+auto registry<Policies...>::compiler::vtbl_group(
+    const method& m, const vtbl_entry& entry) -> std::size_t {
+    if constexpr (has_premultiplied_strides) {
+        if (!m.symmetric) {
+            // The stride is applied here, instead of at each call.
+            return entry.group_index * m.strides[entry.vp_index - 1];
+        }
+    }
+
+    return entry.group_index;
+}
+
+template<class... Policies>
+void registry<Policies...>::compiler::add_mirrored_overriders(method& m) {
+    using namespace detail;
+
+    // An overrider for (A, B) also stands for (B, A), with the arguments
+    // swapped.
+    m.symmetric = true;
+    auto count = m.specs.size();
+    m.specs.reserve(2 * count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        auto& spec = m.specs[i];
+
+        if (spec.vp[0] == spec.vp[1]) {
+            continue;
+        }
+
+        auto& mirror = m.specs.emplace_back(spec);
+        mirror.vp = {spec.vp[1], spec.vp[0]};
+        mirror.pf = spec.info->pf_swapped;
+        mirror.spec_index = m.specs.size() - 1;
+        mirror.mirrored = true;
+
+        ++trace << "mirror of " << type_name(spec.info->type) << "\n";
+    }
+
+    m.not_implemented.spec_index = m.specs.size();
+    m.ambiguous.spec_index = m.specs.size() + 1;
+}
+
+template<class... Policies>
+void registry<Policies...>::compiler::fold_symmetric_table(
+    method& m, const std::vector<group_map>& groups) {
+    // The classes are grouped in the same way in both dimensions, but the
+    // groups may be numbered differently. Number the groups of the second
+    // dimension like those of the first.
+    auto size = groups[0].size();
+    BOOST_ASSERT(groups[1].size() == size);
+    std::vector<std::size_t> first_to_second(size);
+    std::size_t second = 0;
+
+    for (auto& [mask, group] : groups[1]) {
+        auto some = group.classes[0];
+        auto first = some->vtbl[m.slots[0] - some->first_slot].group_index;
+        first_to_second[first] = second;
+
+        for (auto cls : group.classes) {
+            cls->vtbl[m.slots[1] - cls->first_slot].group_index = first;
+        }
+
+        ++second;
+    }
+
+    // Keep the lower triangle, row by row. The cells were built with the
+    // first dimension varying fastest.
+    std::vector<const overrider*> table;
+    table.reserve(size * (size + 1) / 2);
+
+    for (std::size_t hi = 0; hi < size; ++hi) {
+        for (std::size_t lo = 0; lo <= hi; ++lo) {
+            table.push_back(m.dispatch_table[lo + first_to_second[hi] * size]);
+        }
+    }
+
+    m.dispatch_table.swap(table);
+    m.strides.assign(1, 0);
+}
+
+template<class... Policies>
+void registry<Policies...>::compiler::prepare_interpreted_method(
+    method& m, const std::vector<group_map>& groups, std::size_t cells) {
+    ++trace << "interpreted, " << cells << " cells not built\n";
+
+    m.interpreted = true;
+    m.strides.assign(m.arity() - 1, 0);
+
+    m.group_masks.clear();
+    m.group_masks.resize(m.arity());
+
+    for (std::size_t dim = 0; dim < m.arity(); ++dim) {
+        for (auto& [mask, group] : groups[dim]) {
+            m.group_masks[dim].push_back(mask);
+        }
+    }
+
+    // Sort the overriders so that each one comes before the overriders it is
+    // more specific than.
+    std::vector<const overrider*> unsorted;
+
+    for (auto& spec : m.specs) {
+        unsorted.push_back(&spec);
+    }
+
+    m.interpreted_order.clear();
+
+    while (!unsorted.empty()) {
+        auto iter = std::find_if(
+            unsorted.begin(), unsorted.end(), [&unsorted](auto candidate) {
+                return std::none_of(
+                    unsorted.begin(), unsorted.end(), [candidate](auto other) {
+                        return is_more_specific(other, candidate);
+                    });
+            });
+        BOOST_ASSERT(iter != unsorted.end());
+        m.interpreted_order.push_back(*iter);
+        unsorted.erase(iter);
+    }
+
+    // The 'next' of an overrider is the best of the overriders it is more
+    // specific than.
+    for (auto& spec : m.specs) {
+        std::vector<overrider*> candidates;
+
+        for (auto& other : m.specs) {
+            if (is_base(&other, &spec)) {
+                candidates.push_back(&other);
+            }
+        }
+
+        if (candidates.empty()) {
+            spec.next = &m.not_implemented;
+            continue;
+        }
+
+        std::size_t pick, remaining;
+        select_dominant_overriders(candidates, pick, remaining);
+
+        if constexpr (!has_n2216) {
+            if (remaining > 1) {
+                spec.next = &m.ambiguous;
+                continue;
+            }
+        }
+
+        spec.next = candidates[pick];
+    }
+
+    auto size = interpreted_size(m);
+    m.report.interpreted = 1;
+    m.report.bytes_saved =
+        cells > size ? (cells - size) * sizeof(detail::word) : 0;
+}
+
+template<class... Policies>
+auto registry<Policies...>::compiler::interpreted_size(const method& m)
+    -> std::size_t {
+    constexpr std::size_t bits = sizeof(std::size_t) * CHAR_BIT;
+    auto words = (m.specs.size() + bits - 1) / bits;
+
+    // cells for the first virtual argument, header
+    auto size = m.group_masks[0].size() + 5 + m.arity();
+
+    for (const auto& dim_masks : m.group_masks) {
+        size += dim_masks.size() * words;
+    }
+
+    // dominance matrix, overriders, not_implemented and ambiguous
+    return size + m.specs.size() * words + m.specs.size() + 2;
+}
+
+// Layout of the data of an interpreted method:
+//
+// - one cell per group of the first virtual argument, containing the
+//   interpreter; the v-table entries of the first argument point to them
+// - the header:
+//   [0] the number of groups of the first virtual argument
+//   [1] the number of overriders
+//   [2] the number of words in a set of overriders
+//   [3 + dim] the offset of the sets of applicable overriders for each group
+//   of dimension `dim`
+//   [3 + arity] the offset of the dominance matrix: for each overrider, the
+//   set of overriders it is more specific than
+//   [4 + arity] the offset of the overrider pointers, followed by
+//   not_implemented and ambiguous
+// - the data
+//
+// Offsets are relative to the header. The overriders are sorted from the
+// most specific to the least specific.
+template<class... Policies>
+auto registry<Policies...>::compiler::write_interpreted_data(
+    const method& m, detail::word* first) -> const detail::word* {
+    using namespace detail;
+
+    constexpr std::size_t bits = sizeof(std::size_t) * CHAR_BIT;
+    auto specs = m.specs.size();
+    auto words = (specs + bits - 1) / bits;
+    auto dims = m.arity();
+
+    auto header = std::fill_n(
+        first, m.group_masks[0].size(), word(m.info->interpreter));
+    header[0] = m.group_masks[0].size();
+    header[1] = specs;
+    header[2] = words;
+
+    std::vector<std::size_t> position(specs);
+
+    for (std::size_t i = 0; i < specs; ++i) {
+        position[m.interpreted_order[i] - m.specs.data()] = i;
+    }
+
+    auto iter = header + 5 + dims;
+
+    auto new_set = [&iter, words]() {
+        auto set = iter;
+        iter = std::fill_n(iter, words, word(std::size_t(0)));
+
+        return [set](std::size_t bit) {
+            set[bit / bits].i |= std::size_t(1) << bit % bits;
+        };
+    };
+
+    for (std::size_t dim = 0; dim < dims; ++dim) {
+        header[3 + dim] = std::size_t(iter - header);
+
+        for (const auto& mask : m.group_masks[dim]) {
+            auto set = new_set();
+
+            for (std::size_t i = 0; i < specs; ++i) {
+                if (mask[i]) {
+                    set(position[i]);
+                }
+            }
+        }
+    }
+
+    header[3 + dims] = std::size_t(iter - header);
+
+    for (auto spec : m.interpreted_order) {
+        auto set = new_set();
+
+        for (std::size_t j = 0; j < specs; ++j) {
+            if (is_more_specific(spec, m.interpreted_order[j])) {
+                set(j);
+            }
+        }
+    }
+
+    header[4 + dims] = std::size_t(iter - header);
+
+    for (auto spec : m.interpreted_order) {
+        *iter++ = spec->pf;
+    }
+
+    *iter++ = m.not_implemented.pf;
+    *iter++ = m.ambiguous.pf;
+
+    return header;
+}
+
+template<class... Policies>
+void registry<Policies...>::compiler::reserve_lazy_method(method& m) {
+    using namespace detail;
+
+    ++trace << "Reserving lazy dispatch for "
+            << type_name(m.info->method_type_id) << "\n";
+
+    // All the v-table entries of the method designate the same cell, which
+    // holds the resolver. For multi-methods, the strides are zero, so any
+    // combination of groups resolves to that cell.
+    auto method_index = std::size_t(&m - &methods[0]);
+
+    for (std::size_t dim = 0; dim < m.arity(); ++dim) {
+        for (auto cls : m.vp[dim]->transitive_derived) {
+            auto& entry = cls->vtbl[m.slots[dim] - cls->first_slot];
+            entry.method_index = method_index;
+            entry.vp_index = dim;
+            entry.group_index = 0;
+        }
+    }
+
+    m.strides.assign(m.arity() - 1, 0);
+    m.lazy.pf = m.info->lazy_resolver;
+    m.lazy.method_index = method_index;
+    m.lazy.spec_index = 0;
+    m.dispatch_table.assign(1, &m.lazy);
+
+    if (m.arity() > 1) {
+        m.report.cells = 1;
+    }
+
+    accumulate(m.report, report);
+}
+
+template<class... Policies>
+auto registry<Policies...>::compiler::lazy_instance()
+    -> std::unique_ptr<compiler>& {
+    static std::unique_ptr<compiler> instance;
+
+    return instance;
+}
+
+template<class... Policies>
+auto registry<Policies...>::compiler::lazy_mutex() -> std::mutex& {
+    static std::mutex mutex;
+
+    return mutex;
+}
+
+template<class... Policies>
+void registry<Policies...>::compiler::build_lazy_method(
+    detail::method_info& info) {
+    std::lock_guard<std::mutex> lock(lazy_mutex());
+
+    auto& comp = lazy_instance();
+    auto not_initialized = []() {
+        if constexpr (has_error_handler) {
+            error_handler::error(not_initialized_error());
+        }
+
+        abort();
+    };
+
+    if (!comp) {
+        // The registry was finalized.
+        not_initialized();
+    }
+
+    auto iter = std::find_if(
+        comp->methods.begin(), comp->methods.end(),
+        [&info](const method& m) { return m.info == &info; });
+
+    if (iter == comp->methods.end()) {
+        // The method was added after `initialize`.
+        not_initialized();
+    }
+
+    // Another thread may have built the method while we were waiting.
+    if (!iter->built) {
+        comp->install_lazy_method(*iter);
+    }
+}
+
+template<class... Policies>
+void registry<Policies...>::compiler::install_lazy_method(method& m) {
+    using namespace detail;
+
+    m.dispatch_table.clear();
+    m.strides.clear();
+    m.report = method_report();
+    build_method_tables(m);
+
+    for (auto& overrider : m.specs) {
+        if (overrider.next) {
+            *overrider.info->next =
+                reinterpret_cast<void (*)()>(overrider.next->pf);
+        }
+    }
+
+    auto patch = [](class_* cls, std::size_t slot) -> word& {
+        return const_cast<word*>(*cls->static_vptr)[slot];
+    };
+
+    if (m.arity() == 1) {
+        for (auto cls : m.vp[0]->transitive_derived) {
+            auto& entry = cls->vtbl[m.slots[0] - cls->first_slot];
+            store_release(
+                patch(cls, m.slots[0]),
+                m.dispatch_table[entry.group_index]->pf);
+        }
+
+        m.built = true;
+
+        return;
+    }
+
+    auto& table = lazy_tables.emplace_back();
+
+    if (m.interpreted) {
+        table.resize(interpreted_size(m));
+        m.info->interpreter_data = write_interpreted_data(m, table.data());
+    } else {
+        table.resize(m.dispatch_table.size());
+        std::transform(
+            m.dispatch_table.begin(), m.dispatch_table.end(), table.begin(),
+            [](auto spec) { return spec->pf; });
+    }
+
+    m.gv_dispatch_table = table.data();
+
+    // Callers detect an unbuilt method by looking at the cell designated by
+    // the first virtual argument, before applying the strides. So install
+    // the group indices and the strides first, then the entries for the
+    // first virtual argument, with release stores. Callers load them with
+    // acquire semantics.
+    for (std::size_t dim = 1; dim < m.arity(); ++dim) {
+        for (auto cls : m.vp[dim]->transitive_derived) {
+            auto& entry = cls->vtbl[m.slots[dim] - cls->first_slot];
+            patch(cls, m.slots[dim]) = vtbl_group(m, entry);
+        }
+    }
+
+    std::copy(
+        m.strides.begin(), m.strides.end(),
+        m.info->slots_strides_ptr + m.arity());
+
+    for (auto cls : m.vp[0]->transitive_derived) {
+        auto& entry = cls->vtbl[m.slots[0] - cls->first_slot];
+        store_release(
+            patch(cls, m.slots[0]),
+            table.data() + entry.group_index * m.first_stride);
+    }
+
+    m.built = true;
+}
+
+template<class... Policies>
+void registry<Policies...>::compiler::build_dispatch_table(
+    method& m, std::size_t dim,
+    std::vector<group_map>::const_iterator group_iter, const bitvec& candidates,
+    bool concrete) {
+    using namespace detail;
+
+    indent _(trace);
+    std::size_t group_index = 0;
+
+    for (const auto& [group_mask, group] : *group_iter) {
+        auto mask = candidates & group_mask;
+
+        if constexpr (has_trace) {
+            ++trace << "group " << dim << "/" << group_index << " mask " << mask
+                    << "\n";
+            indent _(trace);
+            for (auto cls : range{group.classes.begin(), group.classes.end()}) {
+                ++trace << type_name(cls->type_ids[0]) << "\n";
+            }
+        }
+
+        if (dim == 0) {
+            std::vector<overrider*> overriders;
+            std::size_t i = 0;
+
+            for (auto& spec : m.specs) {
+                if (mask[i]) {
+                    overriders.push_back(&spec);
+                }
+                ++i;
+            }
+
+            if constexpr (has_trace) {
+                ++trace << "select best of:\n";
+                indent _(trace);
+
+                for (auto& app : overriders) {
+                    ++trace << "#" << app->spec_index << " "
+                            << type_name(app->info->type) << "\n";
+                }
+            }
+
+            std::vector<overrider*> dominants = overriders;
+            std::size_t pick, remaining;
+
+            select_dominant_overriders(dominants, pick, remaining);
+
+            if (remaining == 0) {
+                indent _(trace);
+                ++trace << "not implemented\n";
+                m.dispatch_table.push_back(&m.not_implemented);
+
+                // Only the abstract classes fall in the cells of an empty
+                // group that has no concrete classes.
+                if (!has_drop_abstract_groups ||
+                    (concrete && group.has_concrete_classes)) {
+                    ++m.report.not_implemented;
+                }
+            } else {
+                if constexpr (!has_n2216) {
+                    if (remaining > 1) {
+                        ++trace << "ambiguous\n";
+                        m.dispatch_table.push_back(&m.ambiguous);
+                        ++m.report.ambiguous;
+                        continue;
+                    }
+                }
+
+                auto overrider = dominants[pick];
+                m.dispatch_table.push_back(overrider);
+                ++trace;
+
+                trace << "-> #" << overrider->spec_index << " "
+                      << type_name(overrider->info->type)
+                      << " pf = " << overrider->info->pf;
+
+                if (remaining > 1) {
+                    trace << " (ambiguous)";
+                    ++m.report.ambiguous;
+                }
+
+                trace << "\n";
+
+                // -------------------------------------------------------------
+                // next
+
+                // First remove the dominant overriders from the overriders.
+                // Note that the dominants appear in the overriders in the same
+                // relative order.
+                auto candidate = overriders.begin();
+                remaining = 0;
+
+                for (auto dominant : dominants) {
+                    if (*candidate == dominant) {
+                        *candidate = nullptr;
+                    } else {
+                        ++remaining;
+                    }
+
+                    ++candidate;
+                }
+
+                if (remaining == 0) {
+                    ++trace << "no 'next'\n";
+                    overrider->next = &m.not_implemented;
+                } else {
+                    if constexpr (has_trace) {
+                        ++trace << "for 'next', select best of:\n";
+                        indent _(trace);
+
+                        for (auto& app : overriders) {
+                            if (app) {
+                                ++trace << "#" << app->spec_index << " "
+                                        << type_name(app->info->type) << "\n";
+                            }
+                        }
+                    }
+
+                    select_dominant_overriders(overriders, pick, remaining);
+
+                    if constexpr (!has_n2216) {
+                        if (remaining > 1) {
+                            ++trace << "ambiguous 'next'\n";
+                            overrider->next = &m.ambiguous;
+                            continue;
+                        }
+                    }
+
+                    auto next_overrider = overriders[pick];
+                    overrider->next = next_overrider;
+
+                    ++trace << "-> #" << next_overrider->spec_index << " "
+                            << type_name(next_overrider->info->type)
+                            << " pf = " << next_overrider->info->pf;
+
+                    if (remaining > 1) {
+                        trace << " (ambiguous)";
+                        // do not increment m.report.ambiguous, for same reason
+                    }
+
+                    trace << "\n";
+                }
+            }
+        } else {
+            build_dispatch_table(
+                m, dim - 1, group_iter - 1, mask,
+                concrete && group.has_concrete_classes);
+        }
+
+        ++group_index;
+    }
+}
+
+inline void detail::generic_compiler::accumulate(
+    const method_report& partial, report& total) {
+    total.cells += partial.cells;
+    total.not_implemented += partial.not_implemented != 0;
+    total.ambiguous += partial.ambiguous != 0;
+    total.interpreted += partial.interpreted;
+    total.bytes_saved += partial.bytes_saved;
+    total.abstract_groups += partial.abstract_groups;
+    total.padding += partial.padding;
+    total.inline_rows += partial.inline_rows;
+}
+
+template<class... Policies>
+void registry<Policies...>::compiler::write_global_data() {
+    using namespace policies;
+    using namespace detail;
+
+    static_assert(
+        !((has_premultiplied_strides || has_power_of_two_strides) &&
+          has_interpreted_dispatch),
+        "premultiplied_strides and power_of_two_strides cannot be combined "
+        "with interpreted_dispatch");
+    static_assert(
+        !(has_inline_rows && has_lazy_dispatch),
+        "inline_rows cannot be combined with lazy_dispatch");
+    static_assert(
+        !(has_premultiplied_strides && has_power_of_two_strides),
+        "premultiplied_strides and power_of_two_strides are exclusive");
+    static_assert(
+        !(has_compact_dispatch &&
+          (has_lazy_dispatch || has_interpreted_dispatch)),
+        "compact_dispatch cannot be combined with lazy_dispatch or "
+        "interpreted_dispatch");
+    static_assert(
+        !(has_position_independent &&
+          (has_lazy_dispatch || has_interpreted_dispatch ||
+           has_compact_dispatch)),
+        "position_independent cannot be combined with lazy_dispatch, "
+        "interpreted_dispatch or compact_dispatch");
+    static_assert(
+        !(has_deferred_reclamation &&
+          (has_lazy_dispatch || has_interpreted_dispatch || has_inline_rows ||
+           has_indirect_vptr || has_vptr_cache)),
+        "deferred_reclamation cannot be combined with lazy_dispatch, "
+        "interpreted_dispatch, inline_rows, indirect_vptr, cached_vptr or "
+        "vptr_cache");
+    static_assert(
+        !(has_lazy_dispatch &&
+          has_huge_pages_aux<policy<dispatch_memory>>::value),
+        "huge pages cannot be combined with lazy_dispatch");
+    static_assert(
+        !(has_fallback_dispatch && has_deferred_static_rtti),
+        "fallback_dispatch cannot be combined with deferred_static_rtti");
+
+    auto class_layout = hot_first(classes, [this](const class_& cls) {
+        return class_heat(cls);
+    });
+    auto method_layout = hot_first(methods, [](const method& m) {
+        return method_heat(m);
+    });
+    auto vtbl_owners = share_vtables(class_layout);
+
+    std::size_t compact_data_size = 0;
+    std::vector<std::size_t> table_sizes(methods.size());
+
+    for (std::size_t i = 0; i < methods.size(); ++i) {
+        auto& m = methods[i];
+
+        if (m.interpreted) {
+            table_sizes[i] = interpreted_size(m);
+        } else if (m.arity() == 1 || m.row_size) {
+            // stored in the v-tables
+        } else if (is_compact(m)) {
+            compact_data_size += m.dispatch_table.size();
+        } else {
+            table_sizes[i] = m.dispatch_table.size();
+        }
+    }
+
+    // Place the tables and the v-tables in the dispatch data. By default, they
+    // follow each other, tables first. Under profile_guided_layout, the hot
+    // ones come first, so they share as few cache lines and pages as possible;
+    // a hot item that fits in a cache line does not straddle two, and the
+    // cold ones start on a fresh line.
+    std::vector<std::size_t> table_offsets(methods.size()),
+        vtbl_offsets(classes.size()), vtbl_heats(classes.size());
+    std::size_t dispatch_data_size = has_position_independent ? 2 : 0;
+    static constexpr std::size_t line =
+        policies::profile_guided_layout::cache_line_size / sizeof(word);
+
+    for (std::size_t i = 0; i < classes.size(); ++i) {
+        vtbl_heats[vtbl_owners[i]] += class_heat(classes[i]);
+    }
+
+    auto next_line = [&dispatch_data_size]() {
+        dispatch_data_size = (dispatch_data_size + line - 1) / line * line;
+    };
+
+    auto place = [&dispatch_data_size, &next_line](std::size_t size, bool hot) {
+        if (hot && size <= line && dispatch_data_size % line + size > line) {
+            next_line();
+        }
+
+        auto offset = dispatch_data_size;
+        dispatch_data_size += size;
+
+        return offset;
+    };
+
+    for (auto hot : {true, false}) {
+        if (!has_profile_guided_layout && hot) {
+            continue;
+        }
+
+        for (auto index : method_layout) {
+            if (table_sizes[index] &&
+                (!has_profile_guided_layout ||
+                 (method_heat(methods[index]) != 0) == hot)) {
+                table_offsets[index] = place(table_sizes[index], hot);
+            }
+        }
+
+        for (auto index : class_layout) {
+            if (vtbl_owners[index] == index &&
+                (!has_profile_guided_layout ||
+                 (vtbl_heats[index] != 0) == hot)) {
+                vtbl_offsets[index] = place(classes[index].vtbl.size(), hot);
+            }
+        }
+
+        if (hot) {
+            next_line();
+        }
+    }
+
+    // Under position_independent, the dispatch data starts with a header: a
+    // magic number, and a fingerprint of its layout and contents. If the
+    // application provides an image of the dispatch data with the same
+    // header, use it directly, without building a private copy. After a
+    // previous initialization, the image may be the registry's own dispatch
+    // data, which is about to be released; do not adopt it.
+    const word* image = nullptr;
+    [[maybe_unused]] std::size_t fingerprint = 0;
+
+    if constexpr (has_position_independent) {
+        using shared = policy<policies::position_independent>;
+        fingerprint = dispatch_fingerprint(
+            table_offsets, vtbl_offsets, vtbl_owners, dispatch_data_size);
+
+        if (shared::image && shared::image != dispatch_data.data() &&
+            shared::image_size == dispatch_data_size * sizeof(word)) {
+            auto header = static_cast<const word*>(shared::image);
+
+            if (header[0].i == image_magic && header[1].i == fingerprint) {
+                ++trace << "Using shared image at " << shared::image << "\n";
+                image = header;
+            }
+        }
+    }
+
+    // Build the tables in fresh storage. They are published - i.e. made
+    // visible to method calls - only once they are complete.
+    dispatch_vector<word> new_dispatch_data(image ? 0 : dispatch_data_size);
+    auto gv_first = image ? const_cast<word*>(image) : new_dispatch_data.data();
+    [[maybe_unused]] auto gv_last = gv_first + dispatch_data_size;
+    auto gv_iter = gv_first;
+
+    if constexpr (has_position_independent) {
+        if (!image) {
+            gv_first[0] = image_magic;
+            gv_first[1] = fingerprint;
+        }
+    }
+    dispatch_vector<std::atomic<std::int32_t>> new_compact_data(
+        compact_data_size);
+    auto compact_iter = new_compact_data.data();
+
+    ++trace << "Initializing multi-method dispatch tables at " << gv_iter
+            << "\n";
+
+    for (auto index : method_layout) {
+        auto& m = methods[index];
+        if (m.interpreted) {
+            gv_iter = gv_first + table_offsets[index];
+            ++trace << rflush(4, gv_iter - gv_first) << " "
+                    << " interpreted method "
+                    << type_name(m.info->method_type_id) << "\n";
+            m.gv_dispatch_table = gv_iter;
+            m.gv_interpreter_data = write_interpreted_data(m, gv_iter);
+            m.cells.table_begin = gv_iter - gv_first;
+            gv_iter += interpreted_size(m);
+            m.cells.table_end = gv_iter - gv_first;
+            BOOST_ASSERT(gv_iter <= gv_last);
+        } else if (m.info->arity() > 1 && !m.row_size) {
+            if constexpr (has_trace) {
+                ++trace << rflush(4, table_offsets[index]) << " "
+                        << " method #"
+                        << m.dispatch_table[0]->method_index << " "
+                        << type_name(m.info->method_type_id) << "\n";
+                indent _(trace);
+
+                for (auto& entry : m.dispatch_table) {
+                    ++trace << "spec #" << entry->spec_index << " "
+                            << spec_name(m, entry) << "\n";
+                }
+            }
+
+            if (is_compact(m)) {
+                m.gv_compact_table = compact_iter;
+                m.cells.compact_begin = compact_iter - new_compact_data.data();
+                m.cells.compact_end =
+                    m.cells.compact_begin + m.dispatch_table.size();
+
+                for (auto spec : m.dispatch_table) {
+                    compact_iter++->store(
+                        compact_cell(spec->pf), std::memory_order_relaxed);
+                }
+
+                report.bytes_saved += m.dispatch_table.size() *
+                    (sizeof(word) - sizeof(std::int32_t));
+                continue;
+            }
+
+            gv_iter = gv_first + table_offsets[index];
             m.gv_dispatch_table = gv_iter;
+            m.cells.table_begin = gv_iter - gv_first;
+            m.cells.table_end = m.cells.table_begin + m.dispatch_table.size();
             BOOST_ASSERT(gv_iter + m.dispatch_table.size() <= gv_last);
+
+            if (image) {
+                continue;
+            }
+
             gv_iter = std::transform(
                 m.dispatch_table.begin(), m.dispatch_table.end(), gv_iter,
-                [](auto spec) { return spec->pf; });
+                [](auto spec) { return code_cell(spec->pf); });
         }
     }
 
@@ -1127,14 +2214,20 @@ void registry<Policies...>::compiler::write_global_data() {
                 << "\n";
 
         for (auto& overrider : m.specs) {
-            if (overrider.next) {
+            if (overrider.next && !overrider.mirrored) {
                 ++trace << "#" << overrider.spec_index << " "
                         << spec_name(m, &overrider) << " -> ";
 
                 trace << "#" << overrider.next->spec_index << " "
                       << spec_name(m, overrider.next);
-                *overrider.info->next =
-                    reinterpret_cast<void (*)()>(overrider.next->pf);
+                // Under fallback_dispatch and deferred_reclamation,
+                // overriders may be calling through the pointer in other
+                // threads. Do not write it if it does not change.
+                auto pf = reinterpret_cast<void (*)()>(overrider.next->pf);
+
+                if (load_next(*overrider.info->next) != pf) {
+                    store_next(overrider.info->next, pf);
+                }
             } else {
                 trace << "none";
             }
@@ -1145,12 +2238,31 @@ void registry<Policies...>::compiler::write_global_data() {
 
     ++trace << "Initializing v-tables at " << gv_iter << "\n";
 
-    for (auto& cls : classes) {
-        *cls.static_vptr = gv_iter - cls.first_slot;
+    std::vector<vptr_type> class_vptrs(classes.size());
+
+    for (auto index : class_layout) {
+        auto& cls = classes[index];
+        auto owner = vtbl_owners[index];
+
+        if (owner != index) {
+            ++trace << "vtbl for " << cls << " shared with " << classes[owner]
+                    << "\n";
+            class_vptrs[index] = class_vptrs[owner];
+            continue;
+        }
+
+        gv_iter = gv_first + vtbl_offsets[index];
+        class_vptrs[index] = gv_iter - cls.first_slot;
 
         ++trace << rflush(4, gv_iter - gv_first) << " " << gv_iter
                 << " vtbl for " << cls << " slots " << cls.first_slot << "-"
                 << (cls.first_slot + cls.vtbl.size() - 1) << "\n";
+
+        if (image) {
+            // The image already contains the v-table.
+            continue;
+        }
+
         indent _(trace);
 
         for (auto& entry : cls.vtbl) {
@@ -1164,7 +2276,7 @@ void registry<Policies...>::compiler::write_global_data() {
                 ++trace << type_name(method.info->method_type_id) << "\n";
                 ++trace << spec_name(method, spec);
                 BOOST_ASSERT(gv_iter + 1 <= gv_last);
-                *gv_iter++ = spec->pf;
+                *gv_iter++ = code_cell(spec->pf);
             } else {
                 trace << "vp #" << entry.vp_index << " group #"
                       << entry.group_index << "\n";
@@ -1172,11 +2284,29 @@ void registry<Policies...>::compiler::write_global_data() {
                 ++trace << type_name(method.info->method_type_id);
                 BOOST_ASSERT(gv_iter + 1 <= gv_last);
 
-                if (entry.vp_index == 0) {
+                if (entry.vp_index == 0 && method.row_size) {
+                    auto cell =
+                        entry.group_index * method.row_size + entry.column;
+                    *gv_iter++ = code_cell(method.dispatch_table[cell]->pf);
+                } else if (entry.vp_index == 0 && method.symmetric) {
+                    *gv_iter++ = entry.group_index;
+                } else if (entry.vp_index == 0 && is_compact(method)) {
                     *gv_iter++ = std::uintptr_t(
-                        method.gv_dispatch_table + entry.group_index);
+                        method.gv_compact_table +
+                        entry.group_index * method.first_stride);
+                } else if (entry.vp_index == 0) {
+                    auto row = method.gv_dispatch_table +
+                        entry.group_index * method.first_stride;
+
+                    if constexpr (has_position_independent) {
+                        // An offset from the entry itself.
+                        *gv_iter = std::size_t(row - gv_iter);
+                        ++gv_iter;
+                    } else {
+                        *gv_iter++ = std::uintptr_t(row);
+                    }
                 } else {
-                    *gv_iter++ = entry.group_index;
+                    *gv_iter++ = vtbl_group(method, entry);
                 }
             }
 
@@ -1184,13 +2314,334 @@ void registry<Policies...>::compiler::write_global_data() {
         }
     }
 
-    ++trace << rflush(4, dispatch_data.size()) << " " << gv_iter << " end\n";
+    ++trace << rflush(4, new_dispatch_data.size()) << " " << gv_iter
+            << " end\n";
+
+    ++trace << "Publishing\n";
+
+    for (auto& m : methods) {
+        if (m.info->arity() == 1) {
+            // Uni-methods just need an index in the method table.
+            m.info->slots_strides_ptr[0] = m.slots[0];
+        } else {
+            auto strides_iter = std::copy(
+                m.slots.begin(), m.slots.end(), m.info->slots_strides_ptr);
+            std::copy(m.strides.begin(), m.strides.end(), strides_iter);
+            m.info->interpreter_data = m.gv_interpreter_data;
+
+            if (m.symmetric) {
+                m.info->symmetric_table = m.gv_dispatch_table;
+            }
+
+            m.info->inline_row = m.row_size != 0;
+        }
+
+        m.cells.vtbl_cells = m.arity() == 1 ? 1 : m.row_size;
+        m.info->cells = m.cells;
+    }
+
+    vindex_type last_vindex = 0;
+
+    for (auto& cls : classes) {
+        last_vindex = (std::max)(last_vindex, *cls.static_vindex);
+    }
+
+    dispatch_vector<vptr_type> new_static_vptrs(last_vindex + 1, nullptr);
+    auto class_vptr_iter = class_vptrs.begin();
+
+    for (auto& cls : classes) {
+        auto vptr = *class_vptr_iter++;
+        new_static_vptrs[*cls.static_vindex] = vptr;
+
+        if constexpr (has_deferred_reclamation) {
+            // The library reads the v-table pointers through the generation,
+            // but user code may be reading the previous one.
+            store_release(*cls.static_vptr, vptr);
+        } else {
+            *cls.static_vptr = vptr;
+        }
+    }
+
+    dispatch_data.swap(new_dispatch_data);
+    static_vptrs.swap(new_static_vptrs);
+    compact_dispatch_data.swap(new_compact_data);
+
+    if constexpr (has_deferred_reclamation) {
+        // Threads may still be dispatching through the previous tables.
+        // Keep them alive until `reclaim` is called.
+        retired_dispatch_data.push_back(std::move(new_dispatch_data));
+        retired_static_vptrs.push_back(std::move(new_static_vptrs));
+        retired_compact_dispatch_data.push_back(std::move(new_compact_data));
+    }
+
+    if constexpr (has_position_independent) {
+        using shared = policy<policies::position_independent>;
+
+        if (!image) {
+            shared::image = dispatch_data.data();
+            shared::image_size = dispatch_data.size() * sizeof(word);
+        }
+    }
+
+    if constexpr (has_deferred_reclamation) {
+        // Build a generation containing the slots and strides of all the
+        // methods. The vptr policy adds the v-table pointers to it.
+        using deferred = policy<policies::deferred_reclamation>;
+        auto generation = std::make_unique<typename deferred::generation>();
+        std::size_t size = 0;
+
+        for (auto& m : methods) {
+            if (!m.info->index) {
+                // Indexes are stable across generations.
+                m.info->index = ++deferred::method_count;
+            }
+
+            size += 2 * m.arity() - 1;
+        }
+
+        generation->slots_strides.resize(deferred::method_count + 1);
+        generation->slots_strides_data.resize(size);
+        auto iter = generation->slots_strides_data.data();
+
+        for (auto& m : methods) {
+            generation->slots_strides[m.info->index] = iter;
+            iter = std::copy(m.slots.begin(), m.slots.end(), iter);
+
+            if (m.arity() > 1) {
+                iter = std::copy(m.strides.begin(), m.strides.end(), iter);
+            }
+        }
+
+        generation->static_vptrs = static_vptrs.data();
+        generation->vtbls_begin = reinterpret_cast<std::uintptr_t>(gv_first);
+        generation->vtbls_end = reinterpret_cast<std::uintptr_t>(gv_last);
+
+        // Method calls retry the v-table pointer lookups that fail while
+        // `next` is set, because the vptr policy may replace the type_hash
+        // factors before the generation that goes with them is published.
+        deferred::next.store(generation.get());
+        vptr::initialize(classes.begin(), classes.end());
 
-    if constexpr (has_vptr) {
+        ++trace << "Publishing generation " << generation.get() << "\n";
+        deferred::current.store(generation.get(), std::memory_order_release);
+        deferred::next.store(nullptr);
+        deferred::generations.insert(
+            deferred::generations.begin(), std::move(generation));
+    } else if constexpr (has_vptr) {
         vptr::initialize(classes.begin(), classes.end());
     }
 }
 
+template<class... Policies>
+auto registry<Policies...>::compiler::share_vtables(
+    const std::vector<std::size_t>& layout) -> std::vector<std::size_t> {
+    // Classes that don't override anything, and sibling classes, often have
+    // identical v-tables. Such classes share a single v-table. The entries
+    // designate the same overriders and groups, thus the v-tables contain the
+    // same words once written.
+    std::vector<std::size_t> owners(classes.size());
+    std::iota(owners.begin(), owners.end(), std::size_t(0));
+
+    // With lazy_dispatch, the v-tables are patched per class, after they are
+    // published.
+    if constexpr (!has_lazy_dispatch) {
+        auto hash = [](const class_& cls) {
+            auto h = cls.first_slot;
+
+            for (auto& entry : cls.vtbl) {
+                for (auto value :
+                     {entry.method_index, entry.vp_index, entry.group_index}) {
+                    h = h * 31 + value;
+                }
+            }
+
+            return h;
+        };
+
+        std::unordered_multimap<std::size_t, std::size_t> by_hash;
+
+        // The first class in layout order owns the shared v-table.
+        for (auto i : layout) {
+            auto& cls = classes[i];
+            auto [first, last] = by_hash.equal_range(hash(cls));
+            auto iter = std::find_if(first, last, [this, &cls](auto& other) {
+                auto& candidate = classes[other.second];
+
+                return candidate.first_slot == cls.first_slot &&
+                    candidate.vtbl == cls.vtbl;
+            });
+
+            if (iter == last) {
+                by_hash.emplace(hash(cls), i);
+            } else {
+                owners[i] = iter->second;
+            }
+        }
+    }
+
+    report.unique_vtables = 0;
+
+    for (std::size_t i = 0; i < classes.size(); ++i) {
+        report.unique_vtables += owners[i] == i;
+    }
+
+    return owners;
+}
+
+template<class... Policies>
+template<class Range, class Heat>
+auto registry<Policies...>::compiler::hot_first(const Range& range, Heat heat)
+    -> std::vector<std::size_t> {
+    std::vector<std::size_t> order(range.size());
+    std::iota(order.begin(), order.end(), std::size_t(0));
+
+    if constexpr (has_profile_guided_layout) {
+        std::vector<std::size_t> heats;
+
+        for (auto& item : range) {
+            heats.push_back(heat(item));
+        }
+
+        std::stable_sort(order.begin(), order.end(), [&heats](auto a, auto b) {
+            return heats[a] > heats[b];
+        });
+    }
+
+    return order;
+}
+
+template<class... Policies>
+auto registry<Policies...>::compiler::class_heat(const class_& cls)
+    -> std::size_t {
+    std::size_t heat = 0;
+
+    if constexpr (has_profile_guided_layout) {
+        auto& hits = policy<policies::profile_guided_layout>::class_hits;
+
+        // All the type_ids of a class have the same name.
+        auto iter = hits.find(profile_key(cls.type_ids[0]));
+
+        if (iter != hits.end()) {
+            heat += iter->second;
+        }
+    }
+
+    return heat;
+}
+
+template<class... Policies>
+auto registry<Policies...>::compiler::method_heat(const method& m)
+    -> std::size_t {
+    if constexpr (has_profile_guided_layout) {
+        auto& hits = policy<policies::profile_guided_layout>::method_hits;
+        auto iter = hits.find(profile_key(m.info->method_type_id));
+
+        if (iter != hits.end()) {
+            return iter->second;
+        }
+    }
+
+    return 0;
+}
+
+template<class... Policies>
+auto registry<Policies...>::compiler::profile_key(type_id type)
+    -> std::string {
+    std::ostringstream os;
+    rtti::type_name(type, os);
+
+    return os.str();
+}
+
+template<class... Policies>
+auto registry<Policies...>::compiler::is_compact(const method& m) -> bool {
+    return has_compact_dispatch && m.arity() > 1 && !m.symmetric;
+}
+
+template<class... Policies>
+auto registry<Policies...>::compiler::code_cell(void (*pf)())
+    -> detail::word {
+    if constexpr (has_position_independent) {
+        return std::size_t(
+            reinterpret_cast<std::uintptr_t>(pf) -
+            reinterpret_cast<std::uintptr_t>(&code_origin));
+    } else {
+        return pf;
+    }
+}
+
+template<class... Policies>
+auto registry<Policies...>::compiler::dispatch_fingerprint(
+    const std::vector<std::size_t>& table_offsets,
+    const std::vector<std::size_t>& vtbl_offsets,
+    const std::vector<std::size_t>& vtbl_owners, std::size_t size) const
+    -> std::size_t {
+    // FNV-1a, over the values that determine the dispatch data: the layout,
+    // the overriders - as offsets from the registry's code - and the v-table
+    // entries. It is computed without building the data.
+    std::uint64_t hash = 0xcbf29ce484222325;
+
+    auto add = [&hash](std::size_t value) {
+        hash = (hash ^ value) * 0x100000001b3;
+    };
+
+    add(size);
+
+    for (std::size_t i = 0; i < methods.size(); ++i) {
+        auto& m = methods[i];
+        add(table_offsets[i]);
+        add(m.symmetric);
+        add(m.row_size);
+        add(m.first_stride);
+
+        for (auto stride : m.strides) {
+            add(stride);
+        }
+
+        for (auto spec : m.dispatch_table) {
+            add(code_cell(spec->pf).i);
+        }
+    }
+
+    for (std::size_t i = 0; i < classes.size(); ++i) {
+        auto& cls = classes[i];
+        add(vtbl_owners[i]);
+        add(vtbl_offsets[i]);
+        add(cls.first_slot);
+
+        for (auto& entry : cls.vtbl) {
+            add(entry.method_index);
+            add(entry.vp_index);
+            add(entry.group_index);
+            add(entry.column);
+        }
+    }
+
+    return std::size_t(hash);
+}
+
+template<class... Policies>
+auto registry<Policies...>::compiler::compact_cell(void (*pf)())
+    -> std::int32_t {
+    auto offset = std::intptr_t(
+        reinterpret_cast<std::uintptr_t>(pf) -
+        reinterpret_cast<std::uintptr_t>(&code_origin));
+
+    if (offset < INT32_MIN || offset > INT32_MAX) {
+        // The overrider is too far from the registry's code.
+        if constexpr (has_error_handler) {
+            code_offset_error error;
+            error.overrider = pf;
+            error.offset = offset;
+            error_handler::error(error);
+        }
+
+        abort();
+    }
+
+    return std::int32_t(offset);
+}
+
 template<class... Policies>
 void registry<Policies...>::compiler::select_dominant_overriders(
     std::vector<overrider*>& candidates, std::size_t& pick,
@@ -1208,6 +2659,15 @@ void registry<Policies...>::compiler::select_dominant_overriders(
                     } else if (is_more_specific(candidates[j], candidates[i])) {
                         candidates[i] = nullptr;
                         break; // this one is dead
+                    } else if (candidates[i]->info == candidates[j]->info) {
+                        // An overrider of a symmetric method and its mirror
+                        // image: prefer the original.
+                        if (candidates[i]->mirrored) {
+                            candidates[i] = nullptr;
+                            break;
+                        }
+
+                        candidates[j] = nullptr;
                     }
                 }
             }
@@ -1311,21 +2771,71 @@ void registry<Policies...>::compiler::print(const method_report& r) const {
     }
 
     trace << r.not_implemented << " not implemented, " << r.ambiguous
-          << " ambiguous\n";
+          << " ambiguous";
+
+    if (r.interpreted) {
+        trace << ", " << r.interpreted << " interpreted";
+    }
+
+    if (r.bytes_saved) {
+        trace << ", " << r.bytes_saved << " bytes saved";
+    }
+
+    if (r.inline_rows) {
+        trace << ", " << r.inline_rows << " inline rows";
+    }
+
+    if (r.padding) {
+        trace << ", " << r.padding << " padding cells";
+    }
+
+    if (r.abstract_groups) {
+        trace << ", " << r.abstract_groups << " abstract groups dropped";
+    }
+
+    trace << "\n";
 }
 
 template<class... Policies>
 auto registry<Policies...>::initialize() {
-    compiler comp;
-    comp.initialize();
+    if constexpr (has_lazy_dispatch) {
+        // The compiler is kept alive, to build the dispatch tables of the
+        // methods on demand.
+        std::lock_guard<std::mutex> lock(compiler::lazy_mutex());
+        auto& comp = compiler::lazy_instance();
+        comp = std::make_unique<compiler>();
+        build_method = &compiler::build_lazy_method;
+        comp->initialize();
+
+        // Return a copy of the report only: the compiler's classes, methods
+        // and tables stay in `lazy_instance`.
+        struct lazy_report {
+            decltype(compiler::report) report;
+        };
+
+        return lazy_report{comp->report};
+    } else {
+        compiler comp;
+        comp.initialize();
 
-    return comp;
+        return comp;
+    }
 }
 
 auto initialize() {
     return BOOST_OPENMETHOD_DEFAULT_REGISTRY::initialize();
 }
 
+template<class... Policies>
+auto registry<Policies...>::initialize_async() {
+    return std::async(std::launch::async, [] { return initialize(); });
+}
+
+template<class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY>
+auto initialize_async() {
+    return Registry::initialize_async();
+}
+
 namespace detail {
 
 template<class Policy, typename = void>
@@ -1347,7 +2857,48 @@ auto registry<Policies...>::finalize() -> void {
     });
 
     dispatch_data.clear();
+    static_vptrs.clear();
+    compact_dispatch_data.clear();
+    retired_dispatch_data.clear();
+    retired_static_vptrs.clear();
+    retired_compact_dispatch_data.clear();
     initialized = false;
+    ++epoch;
+
+    if constexpr (has_lazy_dispatch) {
+        std::lock_guard<std::mutex> lock(compiler::lazy_mutex());
+        compiler::lazy_instance().reset();
+    }
+}
+
+namespace detail {
+
+template<class Policy, typename = void>
+struct has_reclaim_aux : std::false_type {};
+
+template<class Policy>
+struct has_reclaim_aux<Policy, std::void_t<decltype(Policy::reclaim)>>
+    : std::true_type {};
+
+} // namespace detail
+
+template<class... Policies>
+auto registry<Policies...>::reclaim() -> void {
+    mp11::mp_for_each<policy_list>([](auto policy) {
+        using fn = typename decltype(policy)::template fn<registry>;
+        if constexpr (detail::has_reclaim_aux<fn>::value) {
+            fn::reclaim();
+        }
+    });
+
+    retired_dispatch_data.clear();
+    retired_static_vptrs.clear();
+    retired_compact_dispatch_data.clear();
+}
+
+template<class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY>
+auto reclaim() -> void {
+    Registry::reclaim();
 }
 
 template<class Registry = BOOST_OPENMETHOD_DEFAULT_REGISTRY>
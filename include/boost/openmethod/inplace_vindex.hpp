@@ -0,0 +1,180 @@
+#ifndef BOOST_OPENMETHOD_inplace_vindex_HPP
+#define BOOST_OPENMETHOD_inplace_vindex_HPP
+
+#include <boost/openmethod/inplace_vptr.hpp>
+
+// =============================================================================
+// inplace_vindex
+
+namespace boost::openmethod {
+
+namespace detail {
+
+template<class>
+struct update_vindex_bases;
+
+template<class To, class Class>
+void update_vindex(Class* obj);
+
+template<class... Bases>
+struct update_vindex_bases<mp11::mp_list<Bases...>> {
+    template<class To, class Class>
+    static void fn(Class* obj) {
+        (update_vindex<To>(static_cast<Bases*>(obj)), ...);
+    }
+};
+
+template<class To, class Class>
+void update_vindex(Class* obj) {
+    using registry = inplace_vptr_registry<Class>;
+    using bases = decltype(boost_openmethod_bases(obj));
+
+    if constexpr (mp11::mp_size<bases>::value == 0) {
+        obj->boost_openmethod_vindex = registry::template static_vindex<To>;
+    } else {
+        update_vindex_bases<bases>::template fn<To, Class>(obj);
+    }
+}
+
+template<class, class, bool>
+class inplace_vindex_aux;
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wnon-template-friend"
+#endif
+
+template<class Class, class Registry>
+class inplace_vindex_aux<Class, Registry, true> {
+  protected:
+    template<class To, class Other>
+    friend void update_vindex(Other*);
+    friend auto boost_openmethod_registry(Class*) -> Registry;
+    friend auto boost_openmethod_bases(Class*) -> mp11::mp_list<>;
+
+    inplace_vindex_aux() {
+        (void)&inplace_vptr_use_classes<Class, Registry>;
+        detail::update_vindex<Class>(static_cast<Class*>(this));
+    }
+
+    ~inplace_vindex_aux() {
+        boost_openmethod_vindex = 0;
+    }
+
+    friend auto
+    boost_openmethod_vptr(const Class& obj, Registry*) -> vptr_type {
+        if constexpr (Registry::has_deferred_reclamation) {
+            // `initialize` may be replacing the table.
+            return Registry::template policy<policies::deferred_reclamation>::
+                current.load(std::memory_order_acquire)
+                    ->static_vptrs[obj.boost_openmethod_vindex];
+        } else {
+            return Registry::static_vptrs[obj.boost_openmethod_vindex];
+        }
+    }
+
+    friend auto
+    boost_openmethod_vindex(const Class& obj, Registry*) -> vindex_type {
+        return obj.boost_openmethod_vindex;
+    }
+
+    vindex_type boost_openmethod_vindex = 0;
+};
+
+template<class Class, class Base>
+class inplace_vindex_aux<Class, Base, false> : inplace_vptr_derived {
+  protected:
+    inplace_vindex_aux() {
+        (void)&inplace_vptr_use_classes<
+            Class, Base, inplace_vptr_registry<Class>>;
+        detail::update_vindex<Class>(static_cast<Class*>(this));
+    }
+
+    ~inplace_vindex_aux() {
+        detail::update_vindex<Base>(
+            static_cast<Base*>(static_cast<Class*>(this)));
+    }
+
+    friend auto boost_openmethod_bases(Class*) -> mp11::mp_list<Base>;
+};
+
+} // namespace detail
+
+//! Embeds a class index in objects.
+//!
+//! `inplace_vindex` is a variant of @ref inplace_vptr that stores a 32-bit
+//! class index, instead of a pointer to the v-table, in objects. The index is
+//! assigned by @ref registry::initialize, and is used to look up the v-table in
+//! the registry's @ref registry::static_vptrs table. Thus objects are smaller,
+//! at the cost of one extra indirection per call.
+//!
+//! The index of a class does not change when `initialize` is called again, so
+//! objects remain valid across re-initializations, without requiring the
+//! @ref policies::indirect_vptr policy.
+//!
+//! The registry may also be a @ref static_registry. In that case, the index is
+//! the position of the class in the registry, a constant, and the static
+//! methods read it instead of looking up the dynamic type of the object.
+//!
+//! The template parameters follow the same rules as for @ref inplace_vptr.
+//! `inplace_vindex` and `inplace_vptr` cannot be mixed in the same hierarchy.
+template<typename...>
+struct inplace_vindex;
+
+template<class Class>
+struct inplace_vindex<Class>
+    : detail::inplace_vindex_aux<
+          Class, BOOST_OPENMETHOD_DEFAULT_REGISTRY, true> {};
+
+template<class Class, class Other>
+struct inplace_vindex<Class, Other>
+    : detail::inplace_vindex_aux<
+          Class, Other,
+          detail::is_registry<Other> || detail::is_static_registry<Other>> {};
+
+template<class Class, class Base1, class Base2, class... MoreBases>
+struct inplace_vindex<Class, Base1, Base2, MoreBases...>
+    : detail::inplace_vptr_derived {
+
+    static_assert(
+        !detail::is_registry<Base1> && !detail::is_registry<Base2> &&
+            (!detail::is_registry<MoreBases> && ...) &&
+            !detail::is_static_registry<Base1> &&
+            !detail::is_static_registry<Base2> &&
+            (!detail::is_static_registry<MoreBases> && ...),
+        "registry can be specified only for root classes");
+
+  protected:
+    inplace_vindex() {
+        (void)&detail::inplace_vptr_use_classes<
+            Class, Base1, Base2, MoreBases...,
+            detail::inplace_vptr_registry<Base1>>;
+        detail::update_vindex<Class>(static_cast<Class*>(this));
+    }
+
+    ~inplace_vindex() {
+        auto obj = static_cast<Class*>(this);
+        detail::update_vindex<Base1>(static_cast<Base1*>(obj));
+        detail::update_vindex<Base2>(static_cast<Base2*>(obj));
+        (detail::update_vindex<MoreBases>(static_cast<MoreBases*>(obj)), ...);
+    }
+
+    friend auto
+    boost_openmethod_registry(Class*) -> detail::inplace_vptr_registry<Base1>;
+    friend auto
+    boost_openmethod_bases(Class*) -> mp11::mp_list<Base1, Base2, MoreBases...>;
+    friend auto boost_openmethod_vptr(
+        const Class& obj,
+        detail::inplace_vptr_registry<Base1>* registry) -> vptr_type {
+        return boost_openmethod_vptr(static_cast<const Base1&>(obj), registry);
+    }
+    friend auto boost_openmethod_vindex(
+        const Class& obj,
+        detail::inplace_vptr_registry<Base1>* registry) -> vindex_type {
+        return boost_openmethod_vindex(
+            static_cast<const Base1&>(obj), registry);
+    }
+};
+
+} // namespace boost::openmethod
+
+#endif // BOOST_OPENMETHOD_inplace_vindex_HPP
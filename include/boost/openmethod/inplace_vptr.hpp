@@ -61,6 +61,12 @@ inline use_classes<Classes...> inplace_vptr_use_classes;
 
 template<class Class, class Registry>
 class inplace_vptr_aux<Class, Registry, true> {
+    // The v-table pointer stored in the object cannot follow the generations.
+    static_assert(
+        !Registry::has_deferred_reclamation,
+        "inplace_vptr cannot be used with deferred_reclamation; use "
+        "inplace_vindex");
+
   protected:
     template<class To, class Other>
     friend void update_vptr(Other*);
@@ -22,6 +22,18 @@ struct enable_forwarder<
     using type = ReturnType;
 };
 
+// The return type of `next`, spelled out so that the overriders' `next` is not
+// instantiated before its first call; static methods find their overriders
+// when they are instantiated.
+template<class Method>
+struct next_return_type;
+
+template<
+    typename Id, typename ReturnType, typename... Parameters, class Registry>
+struct next_return_type<method<Id, ReturnType(Parameters...), Registry>> {
+    using type = ReturnType;
+};
+
 template<class...>
 struct va_args;
 
@@ -54,6 +66,11 @@ struct va_args<ReturnType> {
 
 #define BOOST_OPENMETHOD(NAME, ARGS, ...)                                      \
     struct BOOST_OPENMETHOD_ID(NAME);                                          \
+    template<typename>                                                         \
+    struct BOOST_OPENMETHOD_OVERRIDERS(NAME);                                  \
+    auto boost_openmethod_overriders(BOOST_OPENMETHOD_ID(NAME)*)               \
+        -> ::boost::openmethod::detail::macro_overriders<                      \
+            BOOST_OPENMETHOD_OVERRIDERS(NAME)>;                                \
     template<typename... ForwarderParameters>                                  \
     typename ::boost::openmethod::detail::enable_forwarder<                    \
         void,                                                                  \
@@ -106,7 +123,15 @@ struct va_args<ReturnType> {
         static auto fn ARGS->__VA_ARGS__;                                      \
         static auto has_next() -> bool;                                        \
         template<typename... Args>                                             \
-        static auto next(Args&&... args) -> decltype(auto);                    \
+        static auto next(Args&&... args) ->                                    \
+            typename ::boost::openmethod::detail::next_return_type<            \
+                typename boost_openmethod_detail_locate_method_aux<            \
+                    void ARGS>::type>::type;                                   \
+    };                                                                         \
+    template<>                                                                 \
+    struct BOOST_OPENMETHOD_OVERRIDERS(                                        \
+        NAME)<::boost::openmethod::detail::overrider_key ARGS> {               \
+        using type = BOOST_OPENMETHOD_OVERRIDERS(NAME)<__VA_ARGS__ ARGS>;      \
     };                                                                         \
     inline auto BOOST_OPENMETHOD_OVERRIDERS(                                   \
         NAME)<__VA_ARGS__ ARGS>::has_next() -> bool {                          \
@@ -115,7 +140,10 @@ struct va_args<ReturnType> {
     }                                                                          \
     template<typename... Args>                                                 \
     inline auto BOOST_OPENMETHOD_OVERRIDERS(NAME)<__VA_ARGS__ ARGS>::next(     \
-        Args&&... args) -> decltype(auto) {                                    \
+        Args&&... args) ->                                                     \
+        typename ::boost::openmethod::detail::next_return_type<                \
+            typename boost_openmethod_detail_locate_method_aux<                \
+                void ARGS>::type>::type {                                      \
         BOOST_ASSERT(has_next());                                              \
         return boost_openmethod_detail_locate_method_aux<                      \
             void ARGS>::type::next<fn>(std::forward<Args>(args)...);           \
@@ -0,0 +1,222 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_POLICY_ADDRESS_RANGE_HASH_HPP
+#define BOOST_OPENMETHOD_POLICY_ADDRESS_RANGE_HASH_HPP
+
+#include <boost/openmethod/registry.hpp>
+#include <boost/openmethod/policies/fast_perfect_hash.hpp>
+
+#include <atomic>
+#include <limits>
+#include <vector>
+
+namespace boost::openmethod {
+
+namespace detail {
+
+template<class Registry>
+std::vector<type_id> address_range_hash_control;
+
+}
+
+namespace policies {
+
+//! Hash a @ref type_id by its offset in a compact range of addresses.
+//!
+//! `address_range_hash` implements the @ref type_hash policy using a hash
+//! function in the form `H(x)=(x-B)>>S`, where `B` is the smallest registered
+//! type_id, and `S` is the number of low bits that all the type_ids have in
+//! common with `B`. Thus the function is perfect by construction, and is found
+//! in a single pass over the type_ids.
+//!
+//! This is well suited to type_ids that are addresses of static variables, for
+//! example with @ref static_rtti, which tend to be adjacent in memory. If the
+//! range is too sparse - i.e. if it would require more than four buckets per
+//! type_id, for example because the classes are defined in several shared
+//! libraries - `address_range_hash` falls back to @ref fast_perfect_hash.
+struct address_range_hash : type_hash {
+    //! A model of @ref type_hash::fn.
+    //!
+    //! @tparam Registry The registry containing this policy
+    template<class Registry>
+    class fn {
+        using fallback = fast_perfect_hash::fn<Registry>;
+
+        // Under deferred_reclamation, `hash` may be called while `initialize`
+        // replaces the factors.
+        template<typename T>
+        using factor = std::conditional_t<
+            Registry::has_deferred_reclamation, std::atomic<T>, T>;
+
+        inline static factor<std::size_t> base;
+        inline static factor<std::size_t> shift;
+        inline static factor<std::size_t> max_value;
+        inline static factor<bool> use_fallback;
+        inline static void check(std::size_t index, type_id type);
+
+      public:
+        //! Find the base and shift amount
+        //!
+        //! Computes the range of the type_ids in a single pass. If the range is
+        //! dense enough, uses it; otherwise, initializes the @ref
+        //! fast_perfect_hash fallback.
+        //!
+        //! @tparam ForwardIterator A forward iterator yielding
+        //! @ref IdsToVptr objects
+        //! @param first Beginning of the range
+        //! @param last End of the range
+        template<typename ForwardIterator>
+        static auto initialize(ForwardIterator first, ForwardIterator last)
+            -> std::pair<std::size_t, std::size_t>;
+
+        //! Hash a type id
+        //!
+        //! If `Registry` contains the @ref runtime_checks policy, checks that
+        //! the type id is valid, i.e. if it was present in the set passed to
+        //! @ref initialize. If it is not, signal a @ref unknown_class_error
+        //! using the registry's @ref error_handler if present; then calls
+        //! `abort`. Under @ref deferred_reclamation, the check is left to the
+        //! vptr policy.
+        //!
+        //! @param type The type_id to hash
+        //! @return The hash value
+        BOOST_FORCEINLINE
+        static auto hash(type_id type) -> std::size_t {
+            if (use_fallback) {
+                return fallback::hash(type);
+            }
+
+            auto index =
+                (reinterpret_cast<detail::uintptr>(type) - base) >> shift;
+
+            if constexpr (
+                Registry::has_runtime_checks &&
+                !Registry::has_deferred_reclamation) {
+                check(index, type);
+            }
+
+            return index;
+        }
+
+        //! Releases the memory allocated by `initialize`.
+        static auto finalize() -> void {
+            detail::address_range_hash_control<Registry>.clear();
+            fallback::finalize();
+        }
+    };
+};
+
+template<class Registry>
+template<typename ForwardIterator>
+auto address_range_hash::fn<Registry>::initialize(
+    ForwardIterator first, ForwardIterator last)
+    -> std::pair<std::size_t, std::size_t> {
+    std::size_t min_address = (std::numeric_limits<std::size_t>::max)();
+    std::size_t max_address = 0;
+    std::size_t low_bits = 0;
+    std::size_t count = 0;
+
+    for (auto iter = first; iter != last; ++iter) {
+        for (auto type_iter = iter->type_id_begin();
+             type_iter != iter->type_id_end(); ++type_iter) {
+            auto address = detail::uintptr(*type_iter);
+            min_address = (std::min)(min_address, address);
+            max_address = (std::max)(max_address, address);
+            ++count;
+        }
+    }
+
+    if (count == 0) {
+        use_fallback = false;
+        base = 0;
+        shift = 0;
+        max_value = 0;
+
+        return std::pair{std::size_t(0), std::size_t(0)};
+    }
+
+    // The bits that vary between the type_ids. The lower bits that are zero
+    // here can be shifted out without causing collisions.
+    for (auto iter = first; iter != last; ++iter) {
+        for (auto type_iter = iter->type_id_begin();
+             type_iter != iter->type_id_end(); ++type_iter) {
+            low_bits |= detail::uintptr(*type_iter) - min_address;
+        }
+    }
+
+    // The factors being computed; `hash` may be running meanwhile.
+    std::size_t new_shift = 0;
+
+    while (low_bits != 0 && (low_bits & 1) == 0) {
+        low_bits >>= 1;
+        ++new_shift;
+    }
+
+    auto new_max = (max_address - min_address) >> new_shift;
+    bool too_sparse = new_max / 4 >= count;
+
+    if constexpr (Registry::has_trace && Registry::has_output) {
+        if (Registry::trace::on) {
+            Registry::output::os << "Address range for " << count
+                                 << " types: " << (new_max + 1)
+                                 << " buckets, shift = " << new_shift;
+
+            if (too_sparse) {
+                Registry::output::os << ", too sparse\n";
+            } else {
+                Registry::output::os << "\n";
+            }
+        }
+    }
+
+    if (too_sparse) {
+        auto result = fallback::initialize(first, last);
+        use_fallback = true;
+
+        return result;
+    }
+
+    if constexpr (Registry::has_runtime_checks) {
+        auto& control = detail::address_range_hash_control<Registry>;
+        control.assign(new_max + 1, type_id(detail::uintptr_max));
+
+        for (auto iter = first; iter != last; ++iter) {
+            for (auto type_iter = iter->type_id_begin();
+                 type_iter != iter->type_id_end(); ++type_iter) {
+                control
+                    [(detail::uintptr(*type_iter) - min_address) >>
+                     new_shift] = *type_iter;
+            }
+        }
+    }
+
+    base = min_address;
+    shift = new_shift;
+    max_value = new_max;
+    use_fallback = false;
+
+    return std::pair{std::size_t(0), new_max};
+}
+
+template<class Registry>
+void address_range_hash::fn<Registry>::check(std::size_t index, type_id type) {
+    if (index > max_value ||
+        detail::address_range_hash_control<Registry>[index] != type) {
+
+        if constexpr (Registry::has_error_handler) {
+            unknown_class_error error;
+            error.type = type;
+            Registry::error_handler::error(error);
+        }
+
+        abort();
+    }
+}
+
+} // namespace policies
+} // namespace boost::openmethod
+
+#endif
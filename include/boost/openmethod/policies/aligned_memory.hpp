@@ -0,0 +1,272 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_POLICY_ALIGNED_MEMORY_HPP
+#define BOOST_OPENMETHOD_POLICY_ALIGNED_MEMORY_HPP
+
+#include <boost/openmethod/registry.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace boost::openmethod {
+
+namespace policies {
+
+//! The kind of pages used by @ref aligned_memory.
+enum class page_kind {
+    //! Regular pages, from the heap.
+    normal,
+    //! Transparent huge pages, requested with `madvise(MADV_HUGEPAGE)`.
+    transparent_huge,
+    //! Explicit huge pages, requested with `mmap(MAP_HUGETLB)`. If none are
+    //! available, falls back to transparent huge pages.
+    explicit_huge,
+};
+
+} // namespace policies
+
+namespace detail {
+
+constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+// The number of calls to `mlock` that failed, for each registry.
+template<class Registry>
+inline std::atomic<std::size_t> aligned_memory_lock_failures;
+
+template<
+    class Registry, typename T, std::size_t Alignment,
+    policies::page_kind Pages, bool Lock>
+struct aligned_allocator {
+    static_assert(
+        Alignment != 0 && (Alignment & (Alignment - 1)) == 0,
+        "alignment must be a power of two");
+
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = aligned_allocator<Registry, U, Alignment, Pages, Lock>;
+    };
+
+    aligned_allocator() = default;
+
+    template<typename U>
+    aligned_allocator(
+        const aligned_allocator<Registry, U, Alignment, Pages, Lock>&) {
+    }
+
+    static auto allocate(std::size_t n) -> T* {
+#ifdef __linux__
+        if constexpr (use_mmap) {
+            return static_cast<T*>(map(n * sizeof(T)));
+        }
+#endif
+
+        return static_cast<T*>(::operator new(
+            n * sizeof(T),
+            std::align_val_t((std::max)(Alignment, alignof(T)))));
+    }
+
+    static auto deallocate(T* p, std::size_t n) -> void {
+#ifdef __linux__
+        if constexpr (use_mmap) {
+            munmap(p, mapped_size(n * sizeof(T)));
+            return;
+        }
+#endif
+
+        ::operator delete(
+            p, std::align_val_t((std::max)(Alignment, alignof(T))));
+    }
+
+    template<typename U>
+    auto operator==(
+        const aligned_allocator<Registry, U, Alignment, Pages, Lock>&) const
+        -> bool {
+        return true;
+    }
+
+    template<typename U>
+    auto operator!=(
+        const aligned_allocator<Registry, U, Alignment, Pages, Lock>&) const
+        -> bool {
+        return false;
+    }
+
+  private:
+#ifdef __linux__
+    static constexpr bool use_mmap = Pages != policies::page_kind::normal ||
+        Lock || Alignment > std::size_t(4096);
+
+    static auto mapped_size(std::size_t size) -> std::size_t {
+        auto page = Pages == policies::page_kind::normal
+            ? (std::max)(Alignment, std::size_t(4096))
+            : (std::max)(Alignment, huge_page_size);
+
+        return (size + page - 1) / page * page;
+    }
+
+    // Maps whole pages, aligned on their size. The pages are populated, so
+    // they don't fault on the first calls.
+    static auto map(std::size_t size) -> void* {
+        size = mapped_size(size);
+        constexpr int prot = PROT_READ | PROT_WRITE;
+        constexpr int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE;
+
+        if constexpr (Pages == policies::page_kind::explicit_huge) {
+            auto p = mmap(nullptr, size, prot, flags | MAP_HUGETLB, -1, 0);
+
+            if (p != MAP_FAILED) {
+                lock(p, size);
+
+                return p;
+            }
+        }
+
+        // Over-allocate, then trim the unaligned head and the excess tail.
+        auto page = Pages == policies::page_kind::normal
+            ? (std::max)(Alignment, std::size_t(4096))
+            : (std::max)(Alignment, huge_page_size);
+        auto p = mmap(nullptr, size + page, prot, flags, -1, 0);
+
+        if (p == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        auto first = reinterpret_cast<std::uintptr_t>(p);
+        auto aligned = (first + page - 1) / page * page;
+
+        if (aligned != first) {
+            munmap(p, aligned - first);
+        }
+
+        if (auto tail = first + size + page - (aligned + size)) {
+            munmap(reinterpret_cast<void*>(aligned + size), tail);
+        }
+
+        p = reinterpret_cast<void*>(aligned);
+
+        if constexpr (Pages != policies::page_kind::normal) {
+            madvise(p, size, MADV_HUGEPAGE);
+        }
+
+        lock(p, size);
+
+        return p;
+    }
+
+    static auto lock(void* p, std::size_t size) -> void {
+        if constexpr (Lock) {
+            // Fails if RLIMIT_MEMLOCK is too low. The pages are populated, but
+            // may be paged out.
+            if (mlock(p, size) != 0) {
+                auto error = errno;
+                ++aligned_memory_lock_failures<Registry>;
+
+                if constexpr (Registry::has_trace && Registry::has_output) {
+                    if (Registry::trace::on) {
+                        Registry::output::os
+                            << "mlock of " << size
+                            << " bytes of dispatch data failed, errno = "
+                            << error << "\n";
+                    }
+                }
+            }
+        }
+    }
+#endif
+};
+
+template<
+    class Registry, std::size_t Alignment, policies::page_kind Pages,
+    bool Lock>
+struct aligned_memory_fn {
+    template<typename T>
+    using allocator = aligned_allocator<Registry, T, Alignment, Pages, Lock>;
+
+    //! `true` if the blocks are rounded to huge pages.
+    static constexpr bool huge_pages = Pages != policies::page_kind::normal;
+
+    //! Returns the number of blocks that could not be locked in memory.
+    static auto lock_failures() -> std::size_t {
+        return aligned_memory_lock_failures<Registry>.load();
+    }
+};
+
+} // namespace detail
+
+namespace policies {
+
+//! Allocates the dispatch data on cache line boundaries.
+//!
+//! `aligned_memory` implements the @ref dispatch_memory policy. It allocates
+//! the dispatch data - v-tables, dispatch tables and v-table pointer vectors -
+//! on 64-byte boundaries, so each table starts on a cache line.
+//!
+//! @ref aligned_memory_options can, in addition, request huge pages, and lock
+//! the pages in memory.
+struct aligned_memory : dispatch_memory {
+    //! A model of @ref dispatch_memory::fn.
+    //!
+    //! @tparam Registry The registry containing this policy.
+    template<class Registry>
+    struct fn
+        : detail::aligned_memory_fn<Registry, 64, page_kind::normal, false> {
+    };
+};
+
+//! Allocates the dispatch data with a choice of alignment and pages.
+//!
+//! On Linux, if `Pages` is not `page_kind::normal`, or `Lock` is `true`, the
+//! dispatch data is allocated with `mmap`, in whole pages, aligned on the page
+//! size. The pages are populated when they are mapped, thus method calls made
+//! after @ref initialize do not incur page faults in the dispatch data.
+//!
+//! @li `page_kind::transparent_huge` rounds the blocks to 2 MiB, and calls
+//! `madvise(MADV_HUGEPAGE)` on them.
+//!
+//! @li `page_kind::explicit_huge` requests pages from the huge page pool,
+//! with `MAP_HUGETLB`. If the pool is exhausted, it falls back to transparent
+//! huge pages.
+//!
+//! @li If `Lock` is `true`, the pages are locked in memory with `mlock`. The
+//! call fails if it exceeds `RLIMIT_MEMLOCK`. The pages are then populated,
+//! but may be paged out. `fn<Registry>::lock_failures()` returns the number of
+//! blocks that could not be locked; if the registry's trace is enabled, the
+//! failures are also written to its output.
+//!
+//! Huge pages trade memory for fewer TLB misses: each table occupies at least
+//! one 2 MiB page. They are best used in registries with large dispatch data.
+//! Thus they cannot be combined with @ref lazy_dispatch, which allocates one
+//! block per method.
+//!
+//! On other platforms, `Pages` and `Lock` are ignored, and the data is
+//! allocated with an aligned `operator new`.
+//!
+//! @tparam Alignment The alignment of the blocks, a power of two.
+//! @tparam Pages The kind of pages.
+//! @tparam Lock Whether to lock the pages in memory.
+template<
+    std::size_t Alignment = 64, page_kind Pages = page_kind::normal,
+    bool Lock = false>
+struct aligned_memory_options : aligned_memory {
+    template<class Registry>
+    struct fn : detail::aligned_memory_fn<Registry, Alignment, Pages, Lock> {};
+};
+
+} // namespace policies
+
+} // namespace boost::openmethod
+
+#endif
@@ -0,0 +1,345 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_POLICY_CALL_COUNTERS_HPP
+#define BOOST_OPENMETHOD_POLICY_CALL_COUNTERS_HPP
+
+#include <boost/openmethod/registry.hpp>
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace boost::openmethod {
+
+namespace detail {
+
+// A count, written only by the owning thread. `reset` does not write it; it
+// records its value in `base`, which `snapshot` subtracts. `base` is accessed
+// only under the policy's lock.
+struct call_counter {
+    std::atomic<std::size_t> count{0};
+    std::size_t base = 0;
+};
+
+// The counters of one method, for one thread. Only the owning thread writes
+// the counts; other threads read them while taking a snapshot. Inserting an
+// overrider is done under the registry's lock.
+struct call_counters_shard {
+    const method_info* method;
+    call_counter calls;
+    std::unordered_map<void (*)(), call_counter> overriders;
+    void (*last)() = nullptr;
+    call_counter* last_count = nullptr;
+};
+
+template<class Registry, class Method>
+inline thread_local call_counters_shard* call_counters_local = nullptr;
+
+// A plain increment: there is only one writer.
+inline auto increment(call_counter& counter) -> void {
+    counter.count.store(
+        counter.count.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+}
+
+inline auto counted(const call_counter& counter) -> std::size_t {
+    return counter.count.load(std::memory_order_relaxed) - counter.base;
+}
+
+} // namespace detail
+
+//! Method call counts.
+//!
+//! `call_counts` contains the number of calls to each method, and to each
+//! overrider selected by the calls, as collected by the @ref
+//! policies::call_counters policy.
+struct call_counts {
+    //! The call counts of one method.
+    struct method_counts {
+        //! The method.
+        const detail::method_info* method = nullptr;
+        //! The number of calls to the method.
+        std::size_t calls = 0;
+        //! The number of calls, by selected overrider.
+        std::unordered_map<void (*)(), std::size_t> overriders;
+    };
+
+    //! The call counts, by method @ref type_id.
+    std::unordered_map<type_id, method_counts> methods;
+
+    //! Adds the counts of another snapshot to this one.
+    //!
+    //! @param other The counts to add.
+    auto merge(const call_counts& other) -> void {
+        for (auto& [type, counts] : other.methods) {
+            auto& merged = methods[type];
+            merged.method = counts.method;
+            merged.calls += counts.calls;
+
+            for (auto& [pf, calls] : counts.overriders) {
+                merged.overriders[pf] += calls;
+            }
+        }
+    }
+
+    //! Returns the number of calls to each method, by method name.
+    //!
+    //! The result can be assigned to the `method_hits` member of the @ref
+    //! policies::profile_guided_layout policy, possibly in another run of the
+    //! program.
+    //!
+    //! @tparam Registry The registry of the methods.
+    //! @return A map from method name to number of calls.
+    template<class Registry>
+    auto method_hits() const -> std::unordered_map<std::string, std::size_t> {
+        std::unordered_map<std::string, std::size_t> hits;
+
+        for (auto& [type, counts] : methods) {
+            hits[name<Registry>(type)] += counts.calls;
+        }
+
+        return hits;
+    }
+
+    //! Writes the counts to a stream, in text format.
+    //!
+    //! Writes one line per method, followed by one indented line per
+    //! overrider.
+    //!
+    //! @tparam Registry The registry of the methods.
+    //! @tparam Stream A @ref LightweightOutputStream.
+    //! @param os The stream to write to.
+    template<class Registry, class Stream>
+    auto write(Stream& os) const -> void {
+        for (auto& [type, counts] : methods) {
+            os << name<Registry>(type) << ": " << counts.calls << "\n";
+
+            for (auto& [pf, calls] : counts.overriders) {
+                os << "  " << name<Registry>(counts.method, pf) << ": "
+                   << calls << "\n";
+            }
+        }
+    }
+
+    //! Writes the counts to a stream, in JSON format.
+    //!
+    //! Writes an array of objects with members `method`, `calls` and
+    //! `overriders`, the latter being an array of objects with members
+    //! `overrider` and `calls`.
+    //!
+    //! @tparam Registry The registry of the methods.
+    //! @tparam Stream A @ref LightweightOutputStream.
+    //! @param os The stream to write to.
+    template<class Registry, class Stream>
+    auto write_json(Stream& os) const -> void {
+        os << "[";
+        auto comma = "";
+
+        for (auto& [type, counts] : methods) {
+            os << comma << "{\"method\": " << quote(name<Registry>(type))
+               << ", \"calls\": " << counts.calls << ", \"overriders\": [";
+            comma = ", ";
+            auto overrider_comma = "";
+
+            for (auto& [pf, calls] : counts.overriders) {
+                os << overrider_comma << "{\"overrider\": "
+                   << quote(name<Registry>(counts.method, pf))
+                   << ", \"calls\": " << calls << "}";
+                overrider_comma = ", ";
+            }
+
+            os << "]}";
+        }
+
+        os << "]";
+    }
+
+  private:
+    template<class Registry>
+    static auto name(type_id type) -> std::string {
+        std::ostringstream os;
+        Registry::rtti::type_name(type, os);
+
+        return os.str();
+    }
+
+    template<class Registry>
+    static auto name(const detail::method_info* method, void (*pf)())
+        -> std::string {
+        if (method) {
+            if (pf == method->not_implemented) {
+                return "not implemented";
+            }
+
+            if (pf == method->ambiguous) {
+                return "ambiguous";
+            }
+
+            for (auto& overrider : method->specs) {
+                if (pf == overrider.pf || pf == overrider.pf_swapped) {
+                    return name<Registry>(overrider.type);
+                }
+            }
+        }
+
+        std::ostringstream os;
+        os << reinterpret_cast<const void*>(pf);
+
+        return os.str();
+    }
+
+    static auto quote(const std::string& str) -> std::string {
+        std::string quoted = "\"";
+
+        for (auto c : str) {
+            if (c == '"' || c == '\\') {
+                quoted += '\\';
+            }
+
+            quoted += c;
+        }
+
+        return quoted += '"';
+    }
+};
+
+namespace policies {
+
+//! Counts method calls per method and per overrider.
+//!
+//! `call_counters` implements the @ref instrumentation policy. Each thread
+//! counts the calls to each method, and to each overrider selected by the
+//! calls, in counters of its own. Each counter has a single writer, thus
+//! counting a call costs a plain increment - a relaxed atomic load and store,
+//! not a read-modify-write - plus, if the overrider is not the same as in the
+//! previous call to the same method in the same thread, a hash table lookup.
+//!
+//! @ref snapshot adds up the counters of all the threads. It can be called
+//! while other threads are calling methods; the calls made during the
+//! snapshot may or may not be counted. The counters of threads that have
+//! exited are retained.
+//!
+//! @ref reset does not write the counters either. It records their current
+//! values, which `snapshot` subtracts. Thus it does not race with the threads
+//! that are counting calls.
+//!
+//! @par Example
+//! @code
+//! struct counted_registry
+//!     : default_registry::with<policies::call_counters> {};
+//!
+//! // ...
+//!
+//! counted_registry::instrumentation::snapshot()
+//!     .write_json<counted_registry>(std::cout);
+//! @endcode
+struct call_counters : instrumentation {
+    //! A model of @ref instrumentation::fn.
+    //!
+    //! @tparam Registry The registry containing this policy.
+    template<class Registry>
+    class fn {
+        inline static std::mutex mutex;
+        inline static std::list<detail::call_counters_shard> shards;
+
+      public:
+        //! Counts a call to a method.
+        //!
+        //! @tparam Method The method.
+        //! @param method The method object.
+        //! @param pf The overrider selected for the call.
+        template<class Method>
+        BOOST_FORCEINLINE static auto
+        count(const Method& method, void (*pf)()) -> void {
+            auto shard = detail::call_counters_local<Registry, Method>;
+
+            if (!shard) {
+                shard = make_shard(method);
+                detail::call_counters_local<Registry, Method> = shard;
+            }
+
+            detail::increment(shard->calls);
+
+            if (pf != shard->last) {
+                find_overrider(*shard, pf);
+            }
+
+            detail::increment(*shard->last_count);
+        }
+
+        //! Returns the sum of the counts of all the threads.
+        //!
+        //! @return A @ref call_counts object.
+        static auto snapshot() -> call_counts {
+            std::lock_guard<std::mutex> lock(mutex);
+            call_counts counts;
+
+            for (auto& shard : shards) {
+                auto& method_counts =
+                    counts.methods[shard.method->method_type_id];
+                method_counts.method = shard.method;
+                method_counts.calls += detail::counted(shard.calls);
+
+                for (auto& [pf, calls] : shard.overriders) {
+                    method_counts.overriders[pf] += detail::counted(calls);
+                }
+            }
+
+            return counts;
+        }
+
+        //! Sets all the counts to zero.
+        //!
+        //! Calls made concurrently with `reset` may or may not be counted.
+        //! Calls made after `reset` returns are counted.
+        static auto reset() -> void {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            for (auto& shard : shards) {
+                shard.calls.base =
+                    shard.calls.count.load(std::memory_order_relaxed);
+
+                for (auto& [pf, calls] : shard.overriders) {
+                    calls.base = calls.count.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+      private:
+        static auto make_shard(const detail::method_info& method)
+            -> detail::call_counters_shard* {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto& shard = shards.emplace_back();
+            shard.method = &method;
+
+            return &shard;
+        }
+
+        static auto
+        find_overrider(detail::call_counters_shard& shard, void (*pf)())
+            -> void {
+            // Only this thread inserts in the map, thus it can be searched
+            // without locking.
+            auto iter = shard.overriders.find(pf);
+
+            if (iter == shard.overriders.end()) {
+                std::lock_guard<std::mutex> lock(mutex);
+                iter = shard.overriders.try_emplace(pf).first;
+            }
+
+            shard.last = pf;
+            shard.last_count = &iter->second;
+        }
+    };
+};
+
+} // namespace policies
+} // namespace boost::openmethod
+
+#endif
@@ -8,6 +8,7 @@
 
 #include <boost/openmethod/registry.hpp>
 
+#include <atomic>
 #include <limits>
 #include <random>
 #ifdef _MSC_VER
@@ -44,10 +45,16 @@ struct fast_perfect_hash : type_hash {
     //! @tparam Registry The registry containing this policy
     template<class Registry>
     class fn {
-        inline static std::size_t mult;
-        inline static std::size_t shift;
-        inline static std::size_t min_value;
-        inline static std::size_t max_value;
+        // Under deferred_reclamation, `hash` may be called while `initialize`
+        // replaces the factors.
+        using factor = std::conditional_t<
+            Registry::has_deferred_reclamation, std::atomic<std::size_t>,
+            std::size_t>;
+
+        inline static factor mult;
+        inline static factor shift;
+        inline static factor min_value;
+        inline static factor max_value;
         inline static void check(std::size_t index, type_id type);
 
         template<typename ForwardIterator>
@@ -79,7 +86,7 @@ struct fast_perfect_hash : type_hash {
                 initialize(first, last, buckets);
             }
 
-            return std::pair{min_value, max_value};
+            return std::pair<std::size_t, std::size_t>{min_value, max_value};
         }
 
         //! Hash a type id
@@ -92,6 +99,8 @@ struct fast_perfect_hash : type_hash {
         //! method definition, method overrider, or method call was not
         //! registered. In this case, signal a @ref unknown_class_error using
         //! the registry's @ref error_handler if present; then calls `abort`.
+        //! Under @ref deferred_reclamation, the check is left to the vptr
+        //! policy.
         //!
         //! @param type The type_id to hash
         //! @return The hash value
@@ -100,7 +109,9 @@ struct fast_perfect_hash : type_hash {
             auto index =
                 (mult * reinterpret_cast<detail::uintptr>(type)) >> shift;
 
-            if constexpr (Registry::has_runtime_checks) {
+            if constexpr (
+                Registry::has_runtime_checks &&
+                !Registry::has_deferred_reclamation) {
                 check(index, type);
             }
 
@@ -133,6 +144,8 @@ void fast_perfect_hash::fn<Registry>::initialize(
     std::default_random_engine rnd(13081963);
     std::size_t total_attempts = 0;
     std::size_t M = 1;
+    // The factors being tried; `hash` may be running meanwhile.
+    std::size_t new_mult = 0, new_shift = 0, new_min = 0, new_max = 0;
 
     for (auto size = N * 5 / 4; size >>= 1;) {
         ++M;
@@ -141,10 +154,10 @@ void fast_perfect_hash::fn<Registry>::initialize(
     std::uniform_int_distribution<std::size_t> uniform_dist;
 
     for (std::size_t pass = 0; pass < 4; ++pass, ++M) {
-        shift = 8 * sizeof(type_id) - M;
+        new_shift = 8 * sizeof(type_id) - M;
         auto hash_size = 1 << M;
-        min_value = (std::numeric_limits<std::size_t>::max)();
-        max_value = (std::numeric_limits<std::size_t>::min)();
+        new_min = (std::numeric_limits<std::size_t>::max)();
+        new_max = (std::numeric_limits<std::size_t>::min)();
 
         if constexpr (Registry::has_trace && Registry::has_output) {
             if (Registry::trace::on) {
@@ -161,15 +174,16 @@ void fast_perfect_hash::fn<Registry>::initialize(
                 buckets.begin(), buckets.end(), type_id(detail::uintptr_max));
             ++attempts;
             ++total_attempts;
-            mult = uniform_dist(rnd) | 1;
+            new_mult = uniform_dist(rnd) | 1;
 
             for (auto iter = first; iter != last; ++iter) {
                 for (auto type_iter = iter->type_id_begin();
                      type_iter != iter->type_id_end(); ++type_iter) {
                     auto type = *type_iter;
-                    auto index = (detail::uintptr(type) * mult) >> shift;
-                    min_value = (std::min)(min_value, index);
-                    max_value = (std::max)(max_value, index);
+                    auto index =
+                        (detail::uintptr(type) * new_mult) >> new_shift;
+                    new_min = (std::min)(new_min, index);
+                    new_max = (std::max)(new_max, index);
 
                     if (detail::uintptr(buckets[index]) !=
                         detail::uintptr_max) {
@@ -183,12 +197,17 @@ void fast_perfect_hash::fn<Registry>::initialize(
             if constexpr (Registry::has_trace && Registry::has_output) {
                 if (Registry::trace::on) {
                     Registry::output::os
-                        << "  found " << mult << " after " << total_attempts
-                        << " attempts; span = [" << min_value << ", "
-                        << max_value << "]\n";
+                        << "  found " << new_mult << " after "
+                        << total_attempts << " attempts; span = [" << new_min
+                        << ", " << new_max << "]\n";
                 }
             }
 
+            mult = new_mult;
+            shift = new_shift;
+            min_value = new_min;
+            max_value = new_max;
+
             return;
 
         collision: {}
@@ -0,0 +1,234 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_POLICY_TAGGED_RTTI_HPP
+#define BOOST_OPENMETHOD_POLICY_TAGGED_RTTI_HPP
+
+#include <boost/openmethod/registry.hpp>
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace boost::openmethod {
+
+namespace detail {
+
+// The value of the tag of a class that has not been registered yet.
+inline constexpr std::uint32_t tagged_rtti_no_tag = std::uint32_t(-1);
+
+// The tag of each tagged class. It is constant-initialized, thus reading it
+// costs a plain load. `tagged_rtti` assigns it when the class is registered.
+template<class Class>
+inline std::uint32_t tagged_rtti_tag = tagged_rtti_no_tag;
+
+struct tagged_root {
+    std::uint32_t boost_openmethod_tag;
+};
+
+} // namespace detail
+
+//! Embeds a dense type tag in objects.
+//!
+//! `tagged` is a CRTP base for the classes of a hierarchy that uses the @ref
+//! policies::tagged_rtti policy. The root class derives from `tagged<Root>`,
+//! which contains the tag. A derived class derives from `tagged<Derived,
+//! Base>`, which in turn derives from `Base`, and forwards its constructor
+//! arguments to it.
+//!
+//! The constructor of `tagged` sets the tag to the id of its class; the
+//! destructor restores the id of the base class. Thus, as for native virtual
+//! functions, method calls made during construction or destruction dispatch
+//! on the class being constructed or destroyed.
+//!
+//! Only single, non-virtual inheritance is supported.
+//!
+//! @par Example
+//! @code
+//! struct Animal : tagged<Animal> {
+//!     virtual ~Animal() = default;
+//! };
+//!
+//! struct Dog : tagged<Dog, Animal> {};
+//! @endcode
+//!
+//! @tparam Class The class being defined.
+//! @tparam Base The base class, or `void` for a root class.
+template<class Class, class Base = void>
+struct tagged : Base {
+    static_assert(
+        std::is_base_of_v<detail::tagged_root, Base>,
+        "the base class must derive from tagged");
+
+    //! Constructs the base, and sets the tag.
+    tagged() : Base() {
+        this->boost_openmethod_tag = detail::tagged_rtti_tag<Class>;
+    }
+
+    //! Constructs the base, and sets the tag.
+    //!
+    //! Does not take part in overload resolution if `arg` is the only
+    //! argument, and derives from `tagged`; the copy and move constructors
+    //! handle that case.
+    //!
+    //! @param arg, args Arguments forwarded to the constructor of `Base`.
+    template<
+        typename Arg, typename... Args,
+        typename = std::enable_if_t<!std::conjunction_v<
+            std::bool_constant<sizeof...(Args) == 0>,
+            std::is_base_of<tagged, std::decay_t<Arg>>>>>
+    explicit tagged(Arg&& arg, Args&&... args)
+        : Base(std::forward<Arg>(arg), std::forward<Args>(args)...) {
+        this->boost_openmethod_tag = detail::tagged_rtti_tag<Class>;
+    }
+
+    //! Copies the base, and sets the tag.
+    //!
+    //! @param other The object to copy.
+    tagged(const tagged& other) : Base(static_cast<const Base&>(other)) {
+        this->boost_openmethod_tag = detail::tagged_rtti_tag<Class>;
+    }
+
+    //! Moves the base, and sets the tag.
+    //!
+    //! @param other The object to move.
+    tagged(tagged&& other) : Base(static_cast<Base&&>(other)) {
+        this->boost_openmethod_tag = detail::tagged_rtti_tag<Class>;
+    }
+
+    auto operator=(const tagged&) -> tagged& = default;
+    auto operator=(tagged&&) -> tagged& = default;
+
+    //! Restores the tag of the base class.
+    ~tagged() {
+        this->boost_openmethod_tag = detail::tagged_rtti_tag<Base>;
+    }
+};
+
+//! Embeds a dense type tag in objects (root class).
+//!
+//! @tparam Class The class being defined.
+template<class Class>
+struct tagged<Class, void> : detail::tagged_root {
+    //! Sets the tag.
+    tagged() : tagged_root{detail::tagged_rtti_tag<Class>} {
+    }
+
+    //! Sets the tag; the tag of the copied object is ignored.
+    tagged(const tagged&) : tagged() {
+    }
+
+    //! Does nothing: an object's tag does not change after its construction.
+    auto operator=(const tagged&) -> tagged& {
+        return *this;
+    }
+};
+
+namespace policies {
+
+//! Type information from tags stored in objects.
+//!
+//! `tagged_rtti` implements the @ref rtti policy for classes that derive from
+//! @ref tagged. It does not use the C++ RTTI, thus it can be used in programs
+//! compiled with `-fno-rtti`.
+//!
+//! Each class is assigned a tag when it is registered, i.e. when the first
+//! object that refers to it - typically created by @ref
+//! BOOST_OPENMETHOD_CLASSES - is constructed, usually during static
+//! initialization. The tags are dense: in each registry, they are allocated
+//! consecutively, starting from zero. The tag of a class does not change after
+//! it is assigned, thus it survives calls to @ref initialize. Types that do
+//! not derive from @ref tagged - for example, the types of the methods, or of
+//! non-virtual parameters - are identified by the address of a static variable
+//! instead.
+//!
+//! The constructors and the destructor of @ref tagged copy the tag from a
+//! plain static variable. Thus objects must be created after their class is
+//! registered. An object created before, or an object of a class that is not
+//! registered, has an invalid tag. If the registry contains the @ref
+//! runtime_checks policy, a method call with such an object reports an @ref
+//! unknown_class_error; otherwise, the behavior is undefined.
+//!
+//! Combined with @ref vptr_vector, and without a @ref type_hash policy, the
+//! tags are used directly as indexes into the v-table pointer vector.
+//! Obtaining the v-table pointer for an object then costs two loads: the tag,
+//! and the vector entry.
+//!
+//! A tag is stored in the object, which does not know its registry. Thus a
+//! class can be registered in only one registry that uses this policy.
+//!
+//! @par Example
+//! @code
+//! struct tagged_registry
+//!     : registry<
+//!           policies::tagged_rtti, policies::vptr_vector,
+//!           policies::default_error_handler, policies::stderr_output> {};
+//! @endcode
+struct tagged_rtti : rtti {
+    //! A model of @ref rtti::fn.
+    //!
+    //! @tparam Registry The registry containing this policy.
+    template<class Registry>
+    struct fn : rtti::defaults {
+        //! Evaluates to `true` if `Class` derives from @ref tagged.
+        //!
+        //! @tparam Class A class.
+        template<class Class>
+        static constexpr bool is_polymorphic =
+            std::is_base_of_v<detail::tagged_root, Class>;
+
+        //! The next tag to assign.
+        //!
+        //! Not atomic: classes are registered during static initialization,
+        //! or by objects created at run time, which, like all the objects
+        //! that modify the registry, must not be created concurrently.
+        inline static std::uint32_t tag_count = 0;
+
+        //! Returns the @ref type_id of `Class`.
+        //!
+        //! If `Class` derives from @ref tagged, returns its tag, cast to
+        //! `type_id`, assigning it first if needed. Otherwise, returns the
+        //! address of a static variable.
+        //!
+        //! @tparam Class A class.
+        template<class Class>
+        static auto static_type() -> type_id {
+            if constexpr (is_polymorphic<Class>) {
+                auto& tag = detail::tagged_rtti_tag<std::remove_cv_t<Class>>;
+
+                if (tag == detail::tagged_rtti_no_tag) {
+                    tag = tag_count++;
+                }
+
+                return reinterpret_cast<type_id>(std::uintptr_t(tag));
+            } else {
+                static char id;
+
+                return &id;
+            }
+        }
+
+        //! Returns the @ref type_id of the dynamic class of an object.
+        //!
+        //! @tparam Class A class derived from @ref tagged.
+        //! @param obj A reference to an instance of `Class`.
+        template<class Class>
+        static auto dynamic_type(const Class& obj) -> type_id {
+            if constexpr (is_polymorphic<Class>) {
+                return reinterpret_cast<type_id>(std::uintptr_t(
+                    static_cast<const detail::tagged_root&>(obj)
+                        .boost_openmethod_tag));
+            } else {
+                return static_type<Class>();
+            }
+        }
+    };
+};
+
+} // namespace policies
+
+} // namespace boost::openmethod
+
+#endif
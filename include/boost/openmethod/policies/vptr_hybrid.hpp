@@ -0,0 +1,250 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_POLICY_VPTR_HYBRID_HPP
+#define BOOST_OPENMETHOD_POLICY_VPTR_HYBRID_HPP
+
+#include <boost/openmethod/registry.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace boost::openmethod {
+
+namespace policies {
+
+//! Stores v-table pointers in a vector and a map.
+//!
+//! `vptr_hybrid` splits the registered `type_id`s in clusters of close
+//! addresses: two `type_id`s belong to the same cluster if there are less than
+//! `MaxGap` bytes between them, or between the `type_id`s that separate them.
+//! The largest cluster - typically, the `type_info` objects of the main
+//! program - is hashed using the registry's @ref type_hash policy, and its
+//! v-table pointers are stored in a vector, like @ref vptr_vector does. The
+//! other `type_id`s - typically from dynamically loaded libraries - are
+//! stored in a map, like @ref vptr_map does. A single range check selects the
+//! vector or the map.
+//!
+//! Thus calls on objects of the classes of the main program are as fast as
+//! with `vptr_vector`, and the hash function does not need to cope with
+//! addresses scattered across several shared objects.
+//!
+//! If the registry contains the @ref indirect_vptr policy, `vptr_hybrid`
+//! stores pointers to pointers to v-tables.
+//!
+//! @par Requirements
+//!
+//! The registry must contain a @ref type_hash policy. It must not contain the
+//! @ref deferred_reclamation policy.
+//!
+//! @tparam MapFn A mp11 quoted meta-function that takes a key type and a
+//! value type, and returns an @ref AssociativeContainer.
+//! @tparam MaxGap The largest distance, in bytes, between two consecutive
+//! `type_id`s of the same cluster.
+template<
+    class MapFn = mp11::mp_quote<std::unordered_map>,
+    std::size_t MaxGap = (1 << 20)>
+class vptr_hybrid : public vptr {
+  public:
+    //! A model of @ref vptr::fn.
+    //!
+    //! @tparam Registry The registry containing this policy.
+    template<class Registry>
+    class fn {
+        using type_hash =
+            typename Registry::template policy<policies::type_hash>;
+
+        static_assert(
+            !std::is_same_v<type_hash, void>,
+            "vptr_hybrid requires a type_hash policy");
+
+        // The vector and the map are replaced in place by `initialize`, thus
+        // they cannot be read during a re-initialization.
+        static_assert(
+            !Registry::has_deferred_reclamation,
+            "vptr_hybrid cannot be combined with deferred_reclamation");
+
+        using Value = std::conditional_t<
+            Registry::has_indirect_vptr, const vptr_type*, vptr_type>;
+
+        static inline detail::dispatch_vector<Registry, Value> vector;
+        static inline typename MapFn::template fn<type_id, Value> map;
+        static inline detail::uintptr min_address;
+        static inline detail::uintptr span;
+
+        // A type_id and its v-table pointer, fulfilling the requirements of
+        // IdsToVptr needed by type_hash.
+        struct entry {
+            type_id type;
+            Value value;
+
+            auto type_id_begin() const -> const type_id* {
+                return &type;
+            }
+
+            auto type_id_end() const -> const type_id* {
+                return &type + 1;
+            }
+        };
+
+      public:
+        //! Stores the v-table pointers.
+        //!
+        //! Sorts the `type_id`s, and finds the largest cluster. Calls the
+        //! `initialize` function of the @ref type_hash policy with the
+        //! `type_id`s in the cluster, and stores their v-table pointers in a
+        //! vector. Stores the other v-table pointers in a map.
+        //!
+        //! @tparam ForwardIterator A forward iterator yielding
+        //! @ref IdsToVptr objects.
+        //! @param first The beginning of the range.
+        //! @param last The end of the range.
+        template<typename ForwardIterator>
+        static auto
+        initialize(ForwardIterator first, ForwardIterator last) -> void {
+            std::vector<entry> entries;
+
+            for (auto iter = first; iter != last; ++iter) {
+                for (auto type_iter = iter->type_id_begin();
+                     type_iter != iter->type_id_end(); ++type_iter) {
+                    if constexpr (Registry::has_indirect_vptr) {
+                        entries.push_back({*type_iter, &iter->vptr()});
+                    } else {
+                        entries.push_back({*type_iter, iter->vptr()});
+                    }
+                }
+            }
+
+            std::sort(
+                entries.begin(), entries.end(), [](auto& a, auto& b) {
+                    return detail::uintptr(a.type) < detail::uintptr(b.type);
+                });
+
+            std::size_t cluster_first = 0, cluster_last = 0;
+
+            for (std::size_t i = 0, begin = 0; i < entries.size(); ++i) {
+                if (i + 1 == entries.size() ||
+                    detail::uintptr(entries[i + 1].type) -
+                            detail::uintptr(entries[i].type) >
+                        MaxGap) {
+                    if (i + 1 - begin > cluster_last - cluster_first) {
+                        cluster_first = begin;
+                        cluster_last = i + 1;
+                    }
+
+                    begin = i + 1;
+                }
+            }
+
+            map.clear();
+
+            if (cluster_first == cluster_last) {
+                min_address = detail::uintptr_max;
+                span = 0;
+                vector.clear();
+
+                return;
+            }
+
+            auto cluster_begin = entries.begin() + cluster_first;
+            auto cluster_end = entries.begin() + cluster_last;
+            min_address = detail::uintptr(cluster_begin->type);
+            span = detail::uintptr((cluster_end - 1)->type) - min_address;
+
+            if constexpr (Registry::has_trace && Registry::has_output) {
+                if (Registry::trace::on) {
+                    Registry::output::os
+                        << "vptr_hybrid: " << (cluster_last - cluster_first)
+                        << " types in vector, "
+                        << (entries.size() - (cluster_last - cluster_first))
+                        << " in map\n";
+                }
+            }
+
+            auto [_, max_value] =
+                type_hash::initialize(cluster_begin, cluster_end);
+            detail::dispatch_vector<Registry, Value> values(max_value + 1);
+
+            for (auto iter = entries.begin(); iter != entries.end(); ++iter) {
+                if (iter >= cluster_begin && iter < cluster_end) {
+                    values[type_hash::hash(iter->type)] = iter->value;
+                } else {
+                    map.emplace(iter->type, iter->value);
+                }
+            }
+
+            vector.swap(values);
+        }
+
+        //! Returns a reference to a v-table pointer for an object.
+        //!
+        //! Acquires the dynamic @ref type_id of `arg`, using the registry's
+        //! @ref rtti policy. If it falls within the range of the largest
+        //! cluster, hashes it using the @ref type_hash policy, and uses the
+        //! result as an index in the vector. Otherwise, searches the map.
+        //!
+        //! If the registry contains the @ref vptr_cache policy, looks up the
+        //! type id in the calling thread's cache first.
+        //!
+        //! If the registry contains the @ref runtime_checks policy, checks that
+        //! the map contains the type id. If it does not, and if the registry
+        //! contains a @ref error_handler policy, calls its
+        //! @ref error function with a @ref unknown_class_error value, then
+        //! terminates the program with @ref abort. The type ids in the range
+        //! of the cluster are checked by the @ref type_hash policy.
+        //!
+        //! @tparam Class A registered class.
+        //! @param arg A reference to a const object of type `Class`.
+        //! @return A reference to a the v-table pointer for `Class`.
+        template<class Class>
+        static auto dynamic_vptr(const Class& arg) -> const vptr_type& {
+            return detail::find_vptr<Registry>(
+                Registry::rtti::dynamic_type(arg), find);
+        }
+
+        //! Clears the vector and the map.
+        static auto finalize() -> void {
+            vector.clear();
+            map.clear();
+        }
+
+      private:
+        static auto find(type_id type) -> const vptr_type& {
+            const Value* value;
+
+            if (detail::uintptr(type) - min_address <= span) {
+                value = &vector[type_hash::hash(type)];
+            } else {
+                auto iter = map.find(type);
+
+                if constexpr (Registry::has_runtime_checks) {
+                    if (iter == map.end()) {
+                        if constexpr (Registry::has_error_handler) {
+                            unknown_class_error error;
+                            error.type = type;
+                            Registry::error_handler::error(error);
+                        }
+
+                        abort();
+                    }
+                }
+
+                value = &iter->second;
+            }
+
+            if constexpr (Registry::has_indirect_vptr) {
+                return **value;
+            } else {
+                return *value;
+            }
+        }
+    };
+};
+
+} // namespace policies
+} // namespace boost::openmethod
+
+#endif
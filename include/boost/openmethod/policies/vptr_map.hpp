@@ -44,6 +44,12 @@ class vptr_map : public vptr {
         //! @param last The end of the range.
         template<typename ForwardIterator>
         static void initialize(ForwardIterator first, ForwardIterator last) {
+            static_assert(
+                !Registry::has_deferred_reclamation,
+                "deferred_reclamation requires vptr_vector");
+
+            vptrs.clear();
+
             for (auto iter = first; iter != last; ++iter) {
                 for (auto type_iter = iter->type_id_begin();
                      type_iter != iter->type_id_end(); ++type_iter) {
@@ -62,6 +68,9 @@ class vptr_map : public vptr {
         //! Acquires the dynamic @ref type_id of `arg`, using the registry's
         //! @ref rtti policy.
         //!
+        //! If the registry contains the @ref vptr_cache policy, looks up the
+        //! type id in the calling thread's cache first.
+        //!
         //! If the registry contains the @ref runtime_checks policy, checks that
         //! the map contains the type id. If it does not, and if the registry
         //! contains a @ref error_handler policy, calls its
@@ -73,7 +82,17 @@ class vptr_map : public vptr {
         //! @return A reference to a the v-table pointer for `Class`.
         template<class Class>
         static auto dynamic_vptr(const Class& arg) -> const vptr_type& {
-            auto type = Registry::rtti::dynamic_type(arg);
+            return detail::find_vptr<Registry>(
+                Registry::rtti::dynamic_type(arg), find);
+        }
+
+        //! Clears the map.
+        static auto finalize() -> void {
+            vptrs.clear();
+        }
+
+      private:
+        static auto find(type_id type) -> const vptr_type& {
             auto iter = vptrs.find(type);
 
             if constexpr (Registry::has_runtime_checks) {
@@ -94,11 +113,6 @@ class vptr_map : public vptr {
                 return iter->second;
             }
         }
-
-        //! Clears the map.
-        static auto finalize() -> void {
-            vptrs.clear();
-        }
     };
 };
 
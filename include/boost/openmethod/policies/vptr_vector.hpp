@@ -8,7 +8,6 @@
 
 #include <boost/openmethod/registry.hpp>
 
-#include <variant>
 #include <vector>
 
 namespace boost::openmethod {
@@ -16,10 +15,10 @@ namespace boost::openmethod {
 namespace detail {
 
 template<class Registry>
-inline std::vector<vptr_type> vptr_vector_vptrs;
+inline dispatch_vector<Registry, vptr_type> vptr_vector_vptrs;
 
 template<class Registry>
-inline std::vector<const vptr_type*> vptr_vector_indirect_vptrs;
+inline dispatch_vector<Registry, const vptr_type*> vptr_vector_indirect_vptrs;
 
 } // namespace detail
 
@@ -33,6 +32,10 @@ namespace policies {
 //!
 //! If the registry contains the @ref indirect_vptr policy, stores pointers to
 //! pointers to v-tables in the vector.
+//!
+//! If the registry contains the @ref deferred_reclamation policy, stores the
+//! v-table pointers, with their type ids, in the generation being built by
+//! `initialize` instead.
 struct vptr_vector : vptr {
   public:
     //! A model of @ref vptr::fn.
@@ -82,31 +85,18 @@ struct vptr_vector : vptr {
                 ++size;
             }
 
-            if constexpr (Registry::has_indirect_vptr) {
-                detail::vptr_vector_indirect_vptrs<Registry>.resize(size);
+            if constexpr (Registry::has_deferred_reclamation) {
+                install_generation(first, last, size);
+            } else if constexpr (Registry::has_indirect_vptr) {
+                install(
+                    first, last,
+                    detail::dispatch_vector<Registry, const vptr_type*>(size),
+                    detail::vptr_vector_indirect_vptrs<Registry>);
             } else {
-                detail::vptr_vector_vptrs<Registry>.resize(size);
-            }
-
-            for (auto iter = first; iter != last; ++iter) {
-                for (auto type_iter = iter->type_id_begin();
-                     type_iter != iter->type_id_end(); ++type_iter) {
-                    std::size_t index;
-
-                    if constexpr (has_type_hash) {
-                        index = type_hash::hash(*type_iter);
-                    } else {
-                        index = std::size_t(*type_iter);
-                    }
-
-                    if constexpr (Registry::has_indirect_vptr) {
-                        detail::vptr_vector_indirect_vptrs<Registry>[index] =
-                            &iter->vptr();
-                    } else {
-                        detail::vptr_vector_vptrs<Registry>[index] =
-                            iter->vptr();
-                    }
-                }
+                install(
+                    first, last,
+                    detail::dispatch_vector<Registry, vptr_type>(size),
+                    detail::vptr_vector_vptrs<Registry>);
             }
         }
 
@@ -118,6 +108,9 @@ struct vptr_vector : vptr {
         //! If the registry has a @ref type_hash policy, uses it to convert the
         //! type id to an index; otherwise, uses the type_id as the index.
         //!
+        //! If the registry contains the @ref vptr_cache policy, looks up the
+        //! type id in the calling thread's cache first.
+        //!
         //! If the registry contains the @ref runtime_checks policy, verifies
         //! that the index falls within the limits of the vector. If it does
         //! not, and if the registry contains a @ref error_handler policy, calls
@@ -129,13 +122,43 @@ struct vptr_vector : vptr {
         //! @return A reference to a the v-table pointer for `Class`.
         template<class Class>
         static auto dynamic_vptr(const Class& arg) -> const vptr_type& {
-            auto dynamic_type = Registry::rtti::dynamic_type(arg);
-            std::size_t index;
+            return detail::find_vptr<Registry>(
+                Registry::rtti::dynamic_type(arg), find);
+        }
+
+        //! Clears the vector.
+        static auto finalize() -> void {
+            using namespace policies;
+
+            if constexpr (Registry::has_indirect_vptr) {
+                detail::vptr_vector_indirect_vptrs<Registry>.clear();
+            } else {
+                detail::vptr_vector_vptrs<Registry>.clear();
+            }
+
+        };
+
+      private:
+        static auto vector_index(type_id type) -> std::size_t {
             if constexpr (has_type_hash) {
-                index = type_hash::hash(dynamic_type);
+                return type_hash::hash(type);
             } else {
-                index = std::size_t(dynamic_type);
+                return std::size_t(type);
+            }
+        }
+
+        static auto find(type_id type) -> const vptr_type& {
+            if constexpr (Registry::has_deferred_reclamation) {
+                return find_generation(type);
+            } else {
+                return find_vector(type);
+            }
+        }
+
+        static auto find_vector(type_id type) -> const vptr_type& {
+            auto index = vector_index(type);
 
+            if constexpr (!has_type_hash) {
                 if constexpr (Registry::has_runtime_checks) {
                     std::size_t max_index = 0;
 
@@ -149,7 +172,7 @@ struct vptr_vector : vptr {
                     if (index >= max_index) {
                         if constexpr (Registry::has_error_handler) {
                             unknown_class_error error;
-                            error.type = dynamic_type;
+                            error.type = type;
                             Registry::error_handler::error(error);
                         }
 
@@ -165,16 +188,72 @@ struct vptr_vector : vptr {
             }
         }
 
-        //! Clears the vector.
-        static auto finalize() -> void {
-            using namespace policies;
+        template<typename ForwardIterator, class Vector>
+        static auto install(
+            ForwardIterator first, ForwardIterator last, Vector vptrs,
+            Vector& published) -> void {
+            for (auto iter = first; iter != last; ++iter) {
+                for (auto type_iter = iter->type_id_begin();
+                     type_iter != iter->type_id_end(); ++type_iter) {
+                    auto index = vector_index(*type_iter);
 
-            if constexpr (Registry::has_indirect_vptr) {
-                detail::vptr_vector_indirect_vptrs<Registry>.clear();
-            } else {
-                detail::vptr_vector_vptrs<Registry>.clear();
+                    if constexpr (Registry::has_indirect_vptr) {
+                        vptrs[index] = &iter->vptr();
+                    } else {
+                        vptrs[index] = iter->vptr();
+                    }
+                }
             }
-        };
+
+            published.swap(vptrs);
+        }
+
+        template<typename ForwardIterator>
+        static auto install_generation(
+            ForwardIterator first, ForwardIterator last, std::size_t size)
+            -> void {
+            auto& gen = *Registry::template policy<
+                policies::deferred_reclamation>::next.load();
+            gen.vptrs.assign(size, std::pair<type_id, vptr_type>());
+
+            for (auto iter = first; iter != last; ++iter) {
+                for (auto type_iter = iter->type_id_begin();
+                     type_iter != iter->type_id_end(); ++type_iter) {
+                    gen.vptrs[vector_index(*type_iter)] = {
+                        *type_iter, iter->vptr()};
+                }
+            }
+        }
+
+        static auto find_generation(type_id type) -> const vptr_type& {
+            using deferred =
+                typename Registry::template policy<deferred_reclamation>;
+
+            for (;;) {
+                auto gen = deferred::current.load(std::memory_order_acquire);
+                auto index = vector_index(type);
+
+                if (index < gen->vptrs.size() &&
+                    gen->vptrs[index].first == type) {
+                    return gen->vptrs[index].second;
+                }
+
+                // `initialize` may have replaced the hash factors, and not yet
+                // published the generation that goes with them.
+                if (!deferred::next.load() &&
+                    gen == deferred::current.load(std::memory_order_acquire)) {
+                    break;
+                }
+            }
+
+            if constexpr (Registry::has_error_handler) {
+                unknown_class_error error;
+                error.type = type;
+                Registry::error_handler::error(error);
+            }
+
+            abort();
+        }
     };
 };
 
@@ -6,7 +6,13 @@
 #include <boost/mp11/algorithm.hpp>
 #include <boost/mp11/bind.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <stdlib.h>
+#include <string>
+#include <unordered_map>
 #include <vector>
 #ifdef _MSC_VER
 
@@ -36,6 +42,8 @@ namespace boost::openmethod {
 //!
 //! - @ref output: output stream for logging and debugging.
 //!
+//! - @ref dispatch_memory: allocation of the dispatch data.
+//!
 //! - @ref runtime_checks: detect and report common errors.
 //!
 //! - @ref trace: report how dispatch tables are built.
@@ -315,6 +323,583 @@ struct indirect_vptr final {
     struct fn {};
 };
 
+//! Policy to cache v-table pointers in `virtual_ptr`s, validated by an epoch.
+//!
+//! If this policy is present, @ref virtual_ptr stores, in addition to a pointer
+//! to the pointer to the v-table, a copy of the v-table pointer, and the value
+//! of the registry's epoch counter at the time it was made. The counter is
+//! incremented by @ref initialize and @ref finalize. As long as it does not
+//! change, calls use the cached v-table pointer, avoiding the extra indirection
+//! incurred by @ref indirect_vptr. After a re-initialization, a `virtual_ptr`
+//! created earlier reads the v-table pointer via the indirect pointer once,
+//! and caches it again, with the new value of the counter. The copy and the
+//! counter are atomic, thus the `const` member functions of a `virtual_ptr`
+//! may be called concurrently; like its other member functions, they must not
+//! be called concurrently with its assignment.
+//!
+//! `cached_vptr` implies @ref indirect_vptr for all the other constructs, like
+//! @ref inplace_vptr and @ref vptr_vector.
+//!
+//! @par Requirements
+//!
+//! None. `cached_vptr` can be added to a registry's policy list as-is.
+
+struct cached_vptr final {
+    using category = cached_vptr;
+    template<class Registry>
+    struct fn {};
+};
+
+//! Policy to publish the dispatch data atomically, and to defer the release of
+//! the data replaced by `initialize`.
+//!
+//! If this policy is present, @ref initialize builds the new dispatch data in
+//! fresh storage. The data that method calls read, besides the v-tables and
+//! the dispatch tables themselves - the slots and strides of the methods, and
+//! the table that maps type ids to v-table pointers - forms a generation,
+//! published by a single atomic store with release semantics. Method calls
+//! load it with acquire semantics, and resolve the call again if a new
+//! generation was published meanwhile. Thus each call reads a complete
+//! generation, even if it overlaps with `initialize`.
+//!
+//! The previous generations, and the tables they refer to, are kept alive, so
+//! threads that are dispatching through them do not read freed memory. They
+//! are released by @ref registry::reclaim, which should be called once all the
+//! threads have gone through a quiescent state, i.e. after they have completed
+//! the method calls that were in progress during `initialize`.
+//!
+//! The v-table pointers of the classes, by class index, are also part of the
+//! generation. `final_virtual_ptr`, @ref inplace_vindex and the `std::variant`
+//! virtual parameters read them through it. @ref registry::static_vptr is
+//! still updated, with atomic stores with release semantics, but the library
+//! does not read it.
+//!
+//! A `virtual_ptr` holds the v-table pointer of the generation that was
+//! current when it was created. If that generation is no longer current, the
+//! `virtual_ptr` acquires the v-table pointer from the object again, each time
+//! it is used, until it is assigned. This requires the class of the
+//! `virtual_ptr` to be polymorphic, according to the registry's @ref rtti
+//! policy. Objects that carry their own v-table pointer cannot follow the
+//! generations, thus @ref inplace_vptr cannot be used with this policy; @ref
+//! inplace_vindex can.
+//!
+//! `initialize` writes the @ref method::next pointers of the overriders only
+//! if they change, atomically, and `next` reads them atomically. Thus
+//! overriders can call `next` while `initialize` is running.
+//!
+//! Reading the slots through the generation costs two dependent loads per
+//! call. The v-table pointers are looked up in a vector of the generation,
+//! using the registry's @ref type_hash policy. Its factors cannot be replaced
+//! atomically with the generation, thus the entries also contain the type id,
+//! and the lookup is retried while `initialize` is running, if the type ids do
+//! not match. The type_hash policy must thus allow its `hash` function to be
+//! called while its `initialize` function runs; @ref fast_perfect_hash and
+//! @ref address_range_hash do, and skip their runtime checks under this
+//! policy.
+//!
+//! This policy requires @ref vptr_vector. It cannot be combined with @ref
+//! indirect_vptr, @ref cached_vptr, @ref vptr_cache, @ref lazy_dispatch,
+//! @ref interpreted_dispatch or @ref inline_rows, nor used with symmetric
+//! methods.
+//!
+//! @par Requirements
+//!
+//! None. `deferred_reclamation` can be added to a registry's policy list
+//! as-is.
+
+struct deferred_reclamation final {
+    using category = deferred_reclamation;
+
+    template<class Registry>
+    struct fn {
+        // The data read by method calls, besides the tables.
+        struct generation {
+            // The slots and strides of the methods, by method index.
+            std::vector<const std::size_t*> slots_strides;
+            std::vector<std::size_t> slots_strides_data;
+            // Type ids and v-table pointers, stored by vptr_vector, indexed
+            // like its own vector. The type id tells if the entry was found
+            // with the hash factors of this generation.
+            std::vector<std::pair<type_id, vptr_type>> vptrs;
+            // The v-table pointers, by class index.
+            const vptr_type* static_vptrs;
+            // The bounds of the dispatch data, which contains the v-tables.
+            std::uintptr_t vtbls_begin, vtbls_end;
+
+            // Returns `true` if `vptr` points to a v-table of this generation.
+            auto contains(vptr_type vptr) const -> bool {
+                auto address = reinterpret_cast<std::uintptr_t>(vptr);
+
+                return address >= vtbls_begin && address < vtbls_end;
+            }
+        };
+
+        // The generation used by method calls.
+        inline static std::atomic<const generation*> current;
+        // The generation being built by `initialize`, if any. The type_hash
+        // factors may not match `current` meanwhile.
+        inline static std::atomic<generation*> next;
+        // The current generation, followed by the retired ones.
+        inline static std::vector<std::unique_ptr<generation>> generations;
+        // The number of methods that have been given an index.
+        inline static std::size_t method_count;
+
+        static auto reclaim() -> void {
+            generations.resize((std::min)(generations.size(), std::size_t(1)));
+        }
+
+        static auto finalize() -> void {
+            current.store(nullptr, std::memory_order_release);
+            generations.clear();
+        }
+    };
+};
+
+//! Policy to allow method calls before the registry is initialized.
+//!
+//! If this policy is present, method calls made before @ref initialize - or
+//! @ref initialize_async - has completed are legal. They select the overrider
+//! by walking the list of overriders, using the classes' base lists. This is
+//! much slower than table dispatch, but it does not require the dispatch data.
+//! Once the tables are published, calls switch to table dispatch. The `next`
+//! pointers of the overriders also work during that period: @ref method::next
+//! and the `next` function of @ref BOOST_OPENMETHOD_OVERRIDE read them
+//! atomically.
+//!
+//! The fallback path needs the dynamic type of the virtual arguments, thus
+//! the classes must be polymorphic according to the registry's @ref rtti
+//! policy. `virtual_ptr`s created before the tables are published contain a
+//! null v-table pointer; they acquire the v-table pointer from the object,
+//! each time it is needed, once the tables are published.
+//!
+//! The fallback path also needs the type ids of the classes and overriders.
+//! Thus this policy cannot be combined with a @ref deferred_static_rtti
+//! policy, which collects them during initialization.
+//!
+//! @par Requirements
+//!
+//! None. `fallback_dispatch` can be added to a registry's policy list as-is.
+
+struct fallback_dispatch final {
+    using category = fallback_dispatch;
+    template<class Registry>
+    struct fn {};
+};
+
+//! Policy to build the dispatch tables of methods on their first call.
+//!
+//! If this policy is present, @ref initialize assigns the slots in the
+//! v-tables, but it does not build the dispatch tables. Instead, the v-table
+//! entries of the methods point to a resolver. The first call to a method
+//! builds its dispatch table, patches the v-tables, and dispatches the call.
+//! Thus the time and memory spent on dispatch data depend only on the methods
+//! that are actually called.
+//!
+//! The tables are built under a lock. The compiler's data is kept until the
+//! next call to @ref initialize or @ref finalize. `initialize` returns an
+//! object that contains only the report, which counts one dispatch table cell
+//! per multi-method.
+//!
+//! @par Requirements
+//!
+//! None. `lazy_dispatch` can be added to a registry's policy list as-is.
+
+struct lazy_dispatch final {
+    using category = lazy_dispatch;
+    template<class Registry>
+    struct fn {};
+};
+
+//! Policy to store multi-method dispatch tables in 32-bit cells.
+//!
+//! By default, each cell of a multi-method's dispatch table is a pointer-sized
+//! word that holds a pointer to an overrider. If this policy is present, each
+//! cell holds the offset of the overrider from a function in the registry,
+//! stored as a 32-bit integer. Dispatching decodes the cell with a single
+//! addition. This halves the size of the tables on 64-bit platforms, and
+//! lets more of them stay in the caches.
+//!
+//! The v-tables keep pointer-sized entries, because they are shared with
+//! @ref virtual_ptr and the vptr policies.
+//!
+//! All the overriders must be within 2 GiB of the registry's code, which is
+//! the case in most executables. Otherwise, if the registry contains an @ref
+//! error_handler policy, @ref initialize calls its `error` function with a
+//! @ref code_offset_error object, then calls `abort`.
+//! This policy cannot be combined with @ref lazy_dispatch or
+//! @ref interpreted_dispatch. The dispatch tables of symmetric methods are not
+//! compacted.
+//!
+//! @par Requirements
+//!
+//! None. `compact_dispatch` can be added to a registry's policy list as-is.
+
+struct compact_dispatch final {
+    using category = compact_dispatch;
+    template<class Registry>
+    struct fn {};
+};
+
+//! Policy to order the dimensions of dispatch tables by size.
+//!
+//! By default, the dimensions of a multi-method's dispatch table follow the
+//! order of the virtual parameters: the first parameter has a stride of 1, the
+//! second a stride equal to the number of groups in the first dimension, etc.
+//! If this policy is present, the dimension with the most groups has a stride
+//! of 1, followed by the second largest, etc. Thus calls that vary on the most
+//! diverse argument use neighbouring cells.
+//!
+//! The stride of the first virtual parameter is folded into the pointers
+//! stored in the v-tables, and the other strides are stored as usual, so the
+//! dispatch code is the same in both cases.
+//!
+//! @par Requirements
+//!
+//! None. `reorder_dimensions` can be added to a registry's policy list as-is.
+
+struct reorder_dimensions final {
+    using category = reorder_dimensions;
+    template<class Registry>
+    struct fn {};
+};
+
+//! Policy to exclude abstract classes from dispatch tables.
+//!
+//! The dispatch table of a multi-method has one dimension per virtual
+//! parameter, and one row per group of classes that have the same applicable
+//! overriders. Once constructed, an object never has an abstract dynamic
+//! type, so the rows of groups that contain only abstract classes are mostly
+//! unused.
+//!
+//! If this policy is present, the groups of a dimension that contain only
+//! abstract classes are merged in the row for the classes to which no
+//! overrider is applicable, which resolves to the `not_implemented` handler.
+//! If there is no such row - e.g. because an overrider takes the root class
+//! in that position - it is created, provided that it replaces at least two
+//! groups. Thus the policy never adds rows. In hierarchies with several
+//! layers of abstract interfaces, this makes the tables substantially
+//! smaller. The number of rows saved is reported by @ref initialize.
+//!
+//! @note During the construction and the destruction of an object, its
+//! dynamic type is the class of the constructor or destructor being run,
+//! which may be abstract. A method called from there with the object as a
+//! virtual argument dispatches to the `not_implemented` handler, instead of
+//! the overrider it would select without this policy. The same happens with
+//! a misconstructed @ref virtual_ptr.
+//!
+//! Abstract classes are detected with `std::is_abstract`, so this policy has
+//! no effect on classes that are abstract by convention only.
+//!
+//! @par Requirements
+//!
+//! None. `drop_abstract_groups` can be added to a registry's policy list
+//! as-is.
+
+struct drop_abstract_groups final {
+    using category = drop_abstract_groups;
+    template<class Registry>
+    struct fn {};
+};
+
+//! Policy to apply the strides of dispatch tables at initialization time.
+//!
+//! By default, the v-table entry of a multi-method for a virtual parameter
+//! other than the first contains the index of the class's group, and each call
+//! multiplies it by the stride of the dimension, loaded from the method. If
+//! this policy is present, the v-table entries contain the products, so
+//! calls add them directly to the position in the dispatch table. This does
+//! not change the size of the tables.
+//!
+//! This policy cannot be combined with @ref interpreted_dispatch or
+//! @ref power_of_two_strides.
+//!
+//! @par Requirements
+//!
+//! None. `premultiplied_strides` can be added to a registry's policy list
+//! as-is.
+
+struct premultiplied_strides final {
+    using category = premultiplied_strides;
+    template<class Registry>
+    struct fn {};
+};
+
+//! Policy to make the strides of dispatch tables powers of two.
+//!
+//! If this policy is present, the number of groups in each dimension of a
+//! multi-method's dispatch table - except the one with the largest stride -
+//! is rounded up to a power of two. Calls shift group indices instead of
+//! multiplying them by the strides. The padding cells are never used; their
+//! number is reported by @ref initialize, for each method and in total.
+//!
+//! This policy cannot be combined with @ref interpreted_dispatch or
+//! @ref premultiplied_strides.
+//!
+//! @par Requirements
+//!
+//! None. `power_of_two_strides` can be added to a registry's policy list
+//! as-is.
+
+struct power_of_two_strides final {
+    using category = power_of_two_strides;
+    template<class Registry>
+    struct fn {};
+};
+
+//! Policy to resolve multi-methods without dispatch tables.
+//!
+//! If this policy is present, the dispatch tables of some multi-methods are
+//! not built. Instead, calls walk the applicable overriders, ordered from the
+//! most specific to the least specific. This is slower than a table lookup,
+//! but the memory used by a method grows with the sum, instead of the product,
+//! of the number of class groups in each dimension.
+//!
+//! A method is interpreted if @ref interpreted_method is specialized to a true
+//! type for it, or if its dispatch table would contain more than `max_cells`
+//! cells. Each interpreted method may also cache the result of its last
+//! `cache_size` lookups, in each thread.
+//!
+//! The methods that were interpreted, and the memory saved, are listed in the
+//! report returned by @ref initialize.
+//!
+//! @par Requirements
+//!
+//! A subclass of `interpreted_dispatch` may contain a `fn<Registry>` class
+//! template that fulfills the requirements of @ref interpreted_dispatch::fn.
+//! `interpreted_dispatch` itself interprets only the methods that opt in, and
+//! does not use a cache.
+
+struct interpreted_dispatch {
+    using category = interpreted_dispatch;
+
+    //! Options for interpreted dispatch.
+    template<class Registry>
+    struct fn {
+        //! Multi-methods with more cells are interpreted, zero means never.
+        static constexpr std::size_t max_cells = 0;
+        //! The number of entries in the cache of each method, per thread.
+        static constexpr std::size_t cache_size = 0;
+    };
+};
+
+//! Interpreted dispatch with custom options.
+//!
+//! @tparam MaxCells Multi-methods with more cells are interpreted.
+//! @tparam CacheSize The number of entries in the cache of each method, per
+//! thread.
+template<std::size_t MaxCells, std::size_t CacheSize = 0>
+struct interpreted_dispatch_options : interpreted_dispatch {
+    template<class Registry>
+    struct fn {
+        static constexpr std::size_t max_cells = MaxCells;
+        static constexpr std::size_t cache_size = CacheSize;
+    };
+};
+
+//! Policy to store small dispatch table rows in the v-tables.
+//!
+//! By default, the v-table entry of a multi-method for the first virtual
+//! parameter points to a row of the dispatch table, which is then indexed by
+//! the groups of the other virtual arguments. If this policy is present, and
+//! a method has two virtual parameters, and the second one has at most
+//! `max_row` groups, @ref initialize copies each row into the v-tables of the
+//! classes of the first parameter, in consecutive slots. Calls index the
+//! v-table of the first argument by the group of the second argument,
+//! removing one indirection.
+//!
+//! The rows are allocated after the other slots of the v-tables, at a slot
+//! common to all the classes of the first parameter. The number of methods
+//! stored in this way is reported by `initialize`.
+//!
+//! This policy cannot be combined with @ref lazy_dispatch. Symmetric and
+//! interpreted methods are not affected.
+//!
+//! @par Requirements
+//!
+//! A subclass of `inline_rows` may contain a `fn<Registry>` class template
+//! with a `max_row` static constexpr data member of type `std::size_t`.
+//! `inline_rows` itself stores rows of up to 4 cells.
+struct inline_rows {
+    using category = inline_rows;
+
+    //! Options for inline rows.
+    template<class Registry>
+    struct fn {
+        //! The maximum number of cells in a row stored in the v-tables.
+        static constexpr std::size_t max_row = 4;
+    };
+};
+
+//! Inline rows with a custom size limit.
+//!
+//! @tparam MaxRow The maximum number of cells in a row stored in v-tables.
+template<std::size_t MaxRow>
+struct inline_rows_options : inline_rows {
+    template<class Registry>
+    struct fn {
+        static constexpr std::size_t max_row = MaxRow;
+    };
+};
+
+//! Policy to lay out the dispatch data according to an access profile.
+//!
+//! By default, the v-tables and the dispatch tables are laid out in the order
+//! in which the classes and methods were registered. If this policy is
+//! present, @ref initialize uses the hit counts in `class_hits` and
+//! `method_hits` to place the data of the most used classes and methods
+//! first:
+//!
+//! @li The dispatch tables of the methods with hits come first, in decreasing
+//! order of hits, followed by the v-tables of the classes with hits, in
+//! decreasing order of hits. Each of them that fits in a cache line of
+//! `cache_line_size` bytes is placed so that it does not straddle two lines.
+//! Thus the hot data occupies as few cache lines, and pages, as possible.
+//!
+//! @li The cold data - the tables and v-tables of the methods and classes
+//! without hits - starts on the next cache line, in registration order.
+//!
+//! @li In each dimension of a dispatch table, the groups of classes are
+//! numbered in decreasing order of the sum of the hits of their classes.
+//!
+//! Lines are counted from the start of the dispatch data. Combine this policy
+//! with @ref aligned_memory to align the dispatch data on a cache line, or on
+//! a page.
+//!
+//! The profile records how often each class and each method is used, not
+//! which combinations of classes are used together in a method call. Thus
+//! the order of the groups is a heuristic: the cells of the hottest classes
+//! come first in each dimension, but the hottest cells of a table are not
+//! necessarily adjacent.
+//!
+//! The counts are keyed by the names written by the registry's @ref rtti
+//! policy's `type_name` function, which - unlike `type_id`s - are stable
+//! from one run of the program to the next, as long as the policy writes
+//! distinct names for distinct classes. Method hits can be obtained from
+//! @ref call_counts::method_hits; class hits must be supplied by the
+//! application. `write` saves the profile to a stream, and `read` loads it
+//! back, typically in a later run, before calling `initialize`.
+//!
+//! @par Requirements
+//!
+//! A subclass of `profile_guided_layout` may contain a `fn<Registry>` class
+//! template that provides `class_hits` and `method_hits` static data members,
+//! mapping the names of classes and methods to counts.
+struct profile_guided_layout {
+    using category = profile_guided_layout;
+
+    //! The size of a cache line, in bytes.
+    static constexpr std::size_t cache_line_size = 64;
+
+    //! The access profile.
+    template<class Registry>
+    struct fn {
+        //! The number of calls dispatched on each class, by class name.
+        inline static std::unordered_map<std::string, std::size_t> class_hits;
+        //! The number of calls to each method, by method name.
+        inline static std::unordered_map<std::string, std::size_t>
+            method_hits;
+
+        //! Writes the profile to a stream.
+        //!
+        //! Writes one line per class and per method: `class` or `method`,
+        //! the count, and the name, separated by a space.
+        //!
+        //! @tparam Stream A @ref LightweightOutputStream.
+        //! @param os The stream to write to.
+        template<class Stream>
+        static auto write(Stream& os) -> void {
+            for (auto& [name, hits] : class_hits) {
+                os << "class " << hits << " " << name << "\n";
+            }
+
+            for (auto& [name, hits] : method_hits) {
+                os << "method " << hits << " " << name << "\n";
+            }
+        }
+
+        //! Reads a profile written by `write`.
+        //!
+        //! Adds the counts to `class_hits` and `method_hits`.
+        //!
+        //! @tparam Stream An input stream.
+        //! @param is The stream to read from.
+        //! @return `false` if a line is malformed, `true` otherwise.
+        template<class Stream>
+        static auto read(Stream& is) -> bool {
+            std::string kind, name;
+            std::size_t hits;
+
+            while (is >> kind >> hits) {
+                is.get();
+                std::getline(is, name);
+
+                if (kind == "class") {
+                    class_hits[name] += hits;
+                } else if (kind == "method") {
+                    method_hits[name] += hits;
+                } else {
+                    return false;
+                }
+            }
+
+            return is.eof();
+        }
+    };
+};
+
+//! Policy to make the dispatch data position independent.
+//!
+//! By default, the v-tables and the dispatch tables contain the addresses of
+//! the overriders, and of the rows of the dispatch tables. They differ from
+//! one process to another, even for the same program, because of address
+//! space layout randomization. If this policy is present, @ref initialize
+//! stores offsets instead:
+//!
+//! @li The overriders are stored as offsets from a function in the registry.
+//! This is position independent as long as the overriders are in the same
+//! module (executable or shared library) as the registry.
+//!
+//! @li The v-table entries that designate a row of a dispatch table store its
+//! offset from the entry itself.
+//!
+//! Thus several processes running the same program build identical dispatch
+//! data. One of them can copy it into a shared mapping (e.g. a file or a
+//! `memfd`), and the others can use it instead of their private copies, saving
+//! memory.
+//!
+//! The dispatch data starts with a header: a magic number, and a fingerprint
+//! of its layout and contents, computed from the registry's classes, methods
+//! and overriders - the latter as offsets. Before calling `initialize`, set
+//! `image` and `image_size` to a shared copy of the dispatch data. If its size
+//! and header match, `initialize` publishes v-table pointers into the image,
+//! without building the dispatch data. Otherwise, it builds a private copy.
+//! After `initialize`, `image` and `image_size` describe the dispatch data in
+//! use, which can be copied to a shared mapping.
+//!
+//! The image is only read. The v-table pointers, the slots and strides, and
+//! the tables used by the @ref vptr and @ref type_hash policies, which depend
+//! on the addresses of `type_info` objects, remain private to each process.
+//!
+//! This policy cannot be combined with @ref lazy_dispatch,
+//! @ref interpreted_dispatch or @ref compact_dispatch.
+//!
+//! @par Requirements
+//!
+//! A subclass of `position_independent` may contain a `fn<Registry>` class
+//! template that provides `image` and `image_size` static data members.
+struct position_independent {
+    using category = position_independent;
+
+    //! The shared dispatch data.
+    template<class Registry>
+    struct fn {
+        //! The address of the dispatch data.
+        inline static const void* image;
+        //! The size of the dispatch data, in bytes.
+        inline static std::size_t image_size;
+    };
+};
+
 #ifdef __MRDOCS__
 class vptr_vector;
 template<class MapFn>
@@ -367,6 +952,52 @@ struct type_hash {
 class fast_perfect_hash;
 #endif
 
+//! Policy for allocating the dispatch data.
+//!
+//! By default, the dispatch data - v-tables, dispatch tables and v-table
+//! pointer vectors - is stored in `std::vector`s that use `std::allocator`.
+//! If a `dispatch_memory` policy is present, its allocator is used instead.
+//! This makes it possible to control the alignment of the data, the kind of
+//! pages it lives in, and when the pages are faulted in.
+//!
+//! @par Requirements
+//!
+//! A subclass of `dispatch_memory` must contain a `fn<Registry>` class
+//! template that fulfills the requirements of @ref dispatch_memory::fn.
+struct dispatch_memory {
+    using category = dispatch_memory;
+
+#ifdef __MRDOCS__
+    //! Requirements for `dispatch_memory` policies (exposition only)
+    //! @tparam Registry The registry containing this policy.
+    //!
+    //! This class is for _exposition only_. It is the responsibility of
+    //! subclasses to provide a `fn` class template that contains the members
+    //! listed on this page.
+    template<class Registry>
+    struct fn {
+        //! An allocator for objects of type `T`.
+        //!
+        //! `allocator` must fulfill the requirements of the standard
+        //! _Allocator_ named requirement.
+        //!
+        //! @tparam T The type of the objects to allocate.
+        template<typename T>
+        using allocator = Allocator<T>;
+
+        //! `true` if each block occupies at least one huge page (optional).
+        //!
+        //! Such policies cannot be combined with @ref lazy_dispatch, which
+        //! allocates one block per method.
+        static constexpr bool huge_pages = false;
+    };
+#endif
+};
+
+#ifdef __MRDOCS__
+struct aligned_memory;
+#endif
+
 //! Policy for writing diagnostics and trace.
 //!
 //! If an `output` policy is present, the default error handler uses it to write
@@ -436,6 +1067,43 @@ struct trace final {
     };
 };
 
+//! Policy for counting method calls.
+//!
+//! An @e instrumentation policy is notified of each method call, after the
+//! overrider has been selected. If a registry does not contain an
+//! instrumentation policy, the calls are not instrumented, and no code is
+//! generated.
+//!
+//! @par Requirements
+//!
+//! A subclass of `instrumentation` must contain a `fn<Registry>` class
+//! template that fulfills the requirements of @ref instrumentation::fn.
+struct instrumentation {
+    using category = instrumentation;
+
+#ifdef __MRDOCS__
+    //! Requirements for `instrumentation` policies (exposition only).
+    //!
+    //! This class is for _exposition only_. It is the responsibility of
+    //! subclasses to provide a `fn` class template that contains the members
+    //! listed on this page.
+    template<class Registry>
+    struct fn {
+        //! Counts a call to a method.
+        //!
+        //! @tparam Method The method.
+        //! @param method The method object.
+        //! @param pf The overrider selected for the call.
+        template<class Method>
+        static auto count(const Method& method, void (*pf)()) -> void;
+    };
+#endif
+};
+
+#ifdef __MRDOCS__
+struct call_counters;
+#endif
+
 //! Policy for runtime sanity checks.
 //!
 //! If this policy is present, various checks are performed at runtime.
@@ -466,6 +1134,48 @@ struct n2216 final {
     struct fn {};
 };
 
+//! Policy to cache the last v-table pointers found by the vptr policy.
+//!
+//! If this policy is present, @ref vptr_vector and @ref vptr_map keep, per
+//! thread, a small cache of the v-table pointers they returned, keyed by
+//! `type_id`. `dynamic_vptr` looks up the dynamic type of the argument in the
+//! cache before hashing it or searching the map. This pays off when the same
+//! dynamic types are processed many times in a row, e.g. in homogeneous
+//! batches; test/bench_vptr_cache.cpp measures it. The entries are replaced
+//! in round-robin order.
+//!
+//! The cache is invalidated by @ref initialize and @ref finalize, via the
+//! registry's `epoch`.
+//!
+//! @par Requirements
+//!
+//! A subclass of `vptr_cache` may contain a `fn<Registry>` class template with
+//! a `size` static constexpr data member of type `std::size_t`. `vptr_cache`
+//! itself caches one entry.
+struct vptr_cache {
+    using category = vptr_cache;
+
+    //! Options for the v-table pointer cache.
+    template<class Registry>
+    struct fn {
+        //! The number of entries in the cache.
+        static constexpr std::size_t size = 1;
+    };
+};
+
+//! V-table pointer cache with a custom size.
+//!
+//! @tparam Size The number of entries in the cache.
+template<std::size_t Size>
+struct vptr_cache_options : vptr_cache {
+    static_assert(Size > 0, "the cache must have at least one entry");
+
+    template<class Registry>
+    struct fn {
+        static constexpr std::size_t size = Size;
+    };
+};
+
 } // namespace policies
 
 namespace detail {
@@ -475,6 +1185,11 @@ struct registry_base {};
 template<typename T>
 constexpr bool is_registry = std::is_base_of_v<registry_base, T>;
 
+struct static_registry_base {};
+
+template<typename T>
+constexpr bool is_static_registry = std::is_base_of_v<static_registry_base, T>;
+
 template<typename T>
 constexpr bool is_not_void = !std::is_same_v<T, void>;
 
@@ -491,6 +1206,31 @@ struct get_policy_aux<Registry, Size, Size> {
     using type = void;
 };
 
+template<
+    class Registry, class Policies,
+    class Index = mp11::mp_find_if_q<
+        Policies,
+        mp11::mp_bind_front_q<
+            mp11::mp_quote_trait<std::is_base_of>, policies::dispatch_memory>>,
+    class Size = mp11::mp_size<Policies>>
+struct dispatch_allocator_aux {
+    template<typename T>
+    using fn = typename mp11::mp_at<Policies, Index>::template fn<
+        Registry>::template allocator<T>;
+};
+
+template<class Registry, class Policies, class Size>
+struct dispatch_allocator_aux<Registry, Policies, Size, Size> {
+    template<typename T>
+    using fn = std::allocator<T>;
+};
+
+// A vector allocated by the registry's dispatch_memory policy, if any.
+template<
+    class Registry, typename T, class Policies = typename Registry::policy_list>
+using dispatch_vector = std::vector<
+    T, typename dispatch_allocator_aux<Registry, Policies>::template fn<T>>;
+
 using class_catalog = detail::static_list<detail::class_info>;
 using method_catalog = detail::static_list<detail::method_info>;
 
@@ -537,6 +1277,79 @@ struct without_aux<Policies, Policy, MorePolicies...> {
 template<class...>
 struct use_class_aux;
 
+template<class Registry>
+struct fallback_resolver;
+
+// A small cache of the v-table pointers returned by a vptr policy, keyed by
+// type_id, and invalidated when the registry's epoch changes.
+template<std::size_t Size>
+class vptr_cache {
+  public:
+    auto find(std::size_t epoch, type_id type) -> const vptr_type* {
+        if (epoch != this->epoch) {
+            std::fill(std::begin(entries), std::end(entries), entry());
+            this->epoch = epoch;
+
+            return nullptr;
+        }
+
+        for (auto& entry : entries) {
+            if (entry.vptr && entry.type == type) {
+                return entry.vptr;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void insert(std::size_t epoch, type_id type, const vptr_type* vptr) {
+        if (epoch != this->epoch) {
+            return;
+        }
+
+        entries[next] = {type, vptr};
+
+        if (++next == Size) {
+            next = 0;
+        }
+    }
+
+  private:
+    struct entry {
+        type_id type = nullptr;
+        const vptr_type* vptr = nullptr;
+    };
+
+    entry entries[Size];
+    std::size_t next = 0;
+    std::size_t epoch = 0;
+};
+
+template<class Registry, std::size_t Size>
+inline thread_local vptr_cache<Size> vptr_cache_instance;
+
+// Returns `find(type)`, via the calling thread's cache if `Registry` has a
+// vptr_cache policy.
+template<class Registry, class Find>
+auto find_vptr(type_id type, Find find) -> const vptr_type& {
+    if constexpr (Registry::has_vptr_cache) {
+        constexpr auto size =
+            Registry::template policy<policies::vptr_cache>::size;
+        auto& cache = vptr_cache_instance<Registry, size>;
+
+        if (auto vptr = cache.find(Registry::epoch, type)) {
+            return *vptr;
+        }
+
+        auto& vptr = find(type);
+        cache.insert(Registry::epoch, type, &vptr);
+
+        return vptr;
+    } else {
+        return find(type);
+    }
+}
+
 } // namespace detail
 
 //! A collection of methods and their associated dispatch data.
@@ -571,11 +1384,30 @@ class registry : detail::registry_base {
     friend struct detail::use_class_aux;
     template<typename Name, typename ReturnType, class Registry>
     friend class method;
+    template<class Registry>
+    friend struct detail::fallback_resolver;
 
     struct compiler;
 
-    inline static std::vector<detail::word> dispatch_data;
-    inline static bool initialized;
+    template<typename T>
+    using dispatch_vector =
+        detail::dispatch_vector<registry, T, mp11::mp_list<Policies...>>;
+
+    inline static dispatch_vector<detail::word> dispatch_data;
+    inline static std::vector<dispatch_vector<detail::word>>
+        retired_dispatch_data;
+    inline static std::vector<dispatch_vector<vptr_type>> retired_static_vptrs;
+    inline static dispatch_vector<std::atomic<std::int32_t>>
+        compact_dispatch_data;
+    inline static std::vector<dispatch_vector<std::atomic<std::int32_t>>>
+        retired_compact_dispatch_data;
+    inline static std::atomic<bool> initialized;
+    inline static void (*build_method)(detail::method_info&);
+
+    // The origin of the code offsets stored in compact and position
+    // independent dispatch tables.
+    static void code_origin() {
+    }
 
   public:
     //! Initializes the registry.
@@ -597,10 +1429,30 @@ class registry : detail::registry_base {
     //! In addition, policies may encounter and report errors.
     static auto initialize();
 
+    //! Initializes the registry in a background thread.
+    //!
+    //! `initialize_async` runs @ref initialize in a new thread, and returns a
+    //! `std::future` holding its result. The dispatch data is published
+    //! atomically at the end of the initialization. Calling a method before
+    //! that is legal only if the registry contains the @ref
+    //! policies::fallback_dispatch policy.
+    //!
+    //! @note
+    //! A translation unit that contains a call to `initialize_async` must
+    //! include the `<boost/openmethod/initialize.hpp>` header.
+    static auto initialize_async();
+
+    //! Returns `true` if the registry's dispatch data has been published.
+    static auto is_initialized() -> bool {
+        return initialized.load(std::memory_order_acquire);
+    }
+
     //! Checks if the registry is initialized.
     //!
     //! Checks if `initialize` has been called for this registry, and report an
-    //! error if not.
+    //! error if not. If the registry contains the @ref
+    //! policies::fallback_dispatch policy, calls made before initialization
+    //! are legal, and no check is performed.
     //!
     //! @par Errors
     //!
@@ -617,6 +1469,22 @@ class registry : detail::registry_base {
     //! `<boost/openmethod/initialize.hpp>` header.
     static void finalize();
 
+    //! Releases the dispatch data retired by @ref initialize.
+    //!
+    //! If the registry contains the @ref policies::deferred_reclamation
+    //! policy, `initialize` keeps the dispatch data it replaces alive, because
+    //! other threads may still be using it. `reclaim` releases it. It must be
+    //! called only when no thread is executing a method call that started
+    //! before the last call to `initialize`.
+    //!
+    //! `reclaim` also calls the `reclaim` function of the policies that have
+    //! one.
+    //!
+    //! @note
+    //! A translation unit that contains a call to `reclaim` must include the
+    //! `<boost/openmethod/initialize.hpp>` header.
+    static void reclaim();
+
     //! A pointer to the virtual table for a registered class.
     //!
     //! `static_vptr` is set by @ref initialize to the address of the class's
@@ -627,6 +1495,32 @@ class registry : detail::registry_base {
     template<class Class>
     inline static vptr_type static_vptr;
 
+    //! A dense index identifying a registered class.
+    //!
+    //! `static_vindex` is assigned by @ref initialize the first time it sees
+    //! the class, and is not changed by subsequent calls to `initialize`.
+    //! Indexes start at 1; 0 means that the class has not been seen yet.
+    //!
+    //! @tparam Class A registered class.
+    template<class Class>
+    inline static vindex_type static_vindex;
+
+    //! The virtual table pointers, indexed by class index.
+    //!
+    //! `static_vptrs[static_vindex<Class>]` is equal to `static_vptr<Class>`.
+    //! The entry at index 0 is a null pointer. The table is rebuilt by each
+    //! call to @ref initialize, and cleared by @ref finalize.
+    inline static dispatch_vector<vptr_type> static_vptrs;
+
+    //! A counter incremented by @ref initialize and @ref finalize, and by
+    //! `method::replace` in registries that use interpreted dispatch.
+    //!
+    //! `epoch` is used by the @ref policies::cached_vptr policy to detect that
+    //! the v-table pointers cached in `virtual_ptr`s are stale. It is atomic,
+    //! because it is read by method calls that may run concurrently with
+    //! @ref initialize_async.
+    inline static std::atomic<std::size_t> epoch;
+
     //! The list of policies selected in a registry.
     //!
     //! `policy_list` is a Boost.Mp11 list containing the policies passed to the
@@ -709,19 +1603,88 @@ class registry : detail::registry_base {
     static constexpr auto has_runtime_checks =
         !std::is_same_v<policy<policies::runtime_checks>, void>;
 
-    //! `true` if the registry has an indirect_vptr policy.
+    //! `true` if the registry has a cached_vptr policy.
+    static constexpr auto has_cached_vptr =
+        !std::is_same_v<policy<policies::cached_vptr>, void>;
+
+    //! `true` if the registry has an indirect_vptr or a cached_vptr policy.
     static constexpr auto has_indirect_vptr =
-        !std::is_same_v<policy<policies::indirect_vptr>, void>;
+        !std::is_same_v<policy<policies::indirect_vptr>, void> ||
+        has_cached_vptr;
+
+    //! `true` if the registry has a deferred_reclamation policy.
+    static constexpr auto has_deferred_reclamation =
+        !std::is_same_v<policy<policies::deferred_reclamation>, void>;
+
+    //! `true` if the registry has a fallback_dispatch policy.
+    static constexpr auto has_fallback_dispatch =
+        !std::is_same_v<policy<policies::fallback_dispatch>, void>;
+
+    //! `true` if the registry has a compact_dispatch policy.
+    static constexpr auto has_compact_dispatch =
+        !std::is_same_v<policy<policies::compact_dispatch>, void>;
+
+    //! `true` if the registry has a premultiplied_strides policy.
+    static constexpr auto has_premultiplied_strides =
+        !std::is_same_v<policy<policies::premultiplied_strides>, void>;
+
+    //! `true` if the registry has a power_of_two_strides policy.
+    static constexpr auto has_power_of_two_strides =
+        !std::is_same_v<policy<policies::power_of_two_strides>, void>;
+
+    //! `true` if the registry has a dispatch_memory policy.
+    static constexpr auto has_dispatch_memory =
+        !std::is_same_v<policy<policies::dispatch_memory>, void>;
+
+    //! `true` if the registry has a position_independent policy.
+    static constexpr auto has_position_independent =
+        !std::is_same_v<policy<policies::position_independent>, void>;
+
+    //! `true` if the registry has a profile_guided_layout policy.
+    static constexpr auto has_profile_guided_layout =
+        !std::is_same_v<policy<policies::profile_guided_layout>, void>;
+
+    //! `true` if the registry has an inline_rows policy.
+    static constexpr auto has_inline_rows =
+        !std::is_same_v<policy<policies::inline_rows>, void>;
+
+    //! `true` if the registry has a reorder_dimensions policy.
+    static constexpr auto has_reorder_dimensions =
+        !std::is_same_v<policy<policies::reorder_dimensions>, void>;
+
+    //! `true` if the registry has a drop_abstract_groups policy.
+    static constexpr auto has_drop_abstract_groups =
+        !std::is_same_v<policy<policies::drop_abstract_groups>, void>;
+
+    //! `true` if the registry has an interpreted_dispatch policy.
+    static constexpr auto has_interpreted_dispatch =
+        !std::is_same_v<policy<policies::interpreted_dispatch>, void>;
+
+    //! `true` if the registry has a lazy_dispatch policy.
+    static constexpr auto has_lazy_dispatch =
+        !std::is_same_v<policy<policies::lazy_dispatch>, void>;
 
     //! `true` if the registry has a n2216 policy.
     static constexpr auto has_n2216 =
         !std::is_same_v<policy<policies::n2216>, void>;
+
+    //! The registry's instrumentation policy if it contains one, or `void`.
+    using instrumentation = policy<policies::instrumentation>;
+
+    //! `true` if the registry has an instrumentation policy.
+    static constexpr auto has_instrumentation =
+        !std::is_same_v<instrumentation, void>;
+
+    //! `true` if the registry has a vptr_cache policy.
+    static constexpr auto has_vptr_cache =
+        !std::is_same_v<policy<policies::vptr_cache>, void>;
 };
 
 template<class... Policies>
 inline void registry<Policies...>::check_initialized() {
-    if constexpr (registry::has_runtime_checks) {
-        if (!initialized) {
+    if constexpr (
+        registry::has_runtime_checks && !registry::has_fallback_dispatch) {
+        if (!is_initialized()) {
             if constexpr (registry::has_error_handler) {
                 error_handler::error(not_initialized_error());
             }
@@ -770,6 +1733,12 @@ auto fast_perfect_hash_error::write(Stream& os) const -> void {
        << buckets << " buckets\n";
 }
 
+template<class Registry, class Stream>
+auto code_offset_error::write(Stream& os) const -> void {
+    os << "overrider " << reinterpret_cast<const void*>(overrider)
+       << " is too far from the registry's code (offset " << offset << ")";
+}
+
 template<class Registry, class Stream>
 auto static_offset_error::write(Stream& os) const -> void {
     os << "static offset error in ";
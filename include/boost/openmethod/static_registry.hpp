@@ -0,0 +1,870 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_OPENMETHOD_STATIC_REGISTRY_HPP
+#define BOOST_OPENMETHOD_STATIC_REGISTRY_HPP
+
+#include <boost/openmethod/core.hpp>
+
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace boost::openmethod {
+
+template<class... Classes>
+struct static_registry;
+
+template<class StaticRegistry, typename Signature, class Overriders>
+class static_method;
+
+namespace detail {
+
+void boost_openmethod_overriders(...);
+
+template<class Class>
+struct static_registry_classes {
+    using type = mp11::mp_list<Class>;
+};
+
+template<class... Classes>
+struct static_registry_classes<use_classes<Classes...>> {
+    static_assert(
+        (!is_registry<Classes> && ...),
+        "use_classes in a static_registry cannot specify a registry");
+
+    using type = mp11::mp_list<Classes...>;
+};
+
+template<class Type>
+constexpr bool is_static_registry_policy = is_registry<Type>;
+
+template<class... Classes>
+constexpr bool is_static_registry_policy<use_classes<Classes...>> = false;
+
+// The registry that provides the policies, and the classes, as a
+// `boost::mp11::mp_list`. They are not members of `static_registry`, because
+// the registry is instantiated by `inplace_vindex`, in the bases of the root
+// class, while the classes are still incomplete.
+template<class... Classes>
+struct static_registry_traits<static_registry<Classes...>> {
+    using last = mp11::mp_back<mp11::mp_list<Classes...>>;
+
+    using registry = std::conditional_t<
+        is_static_registry_policy<last>, last,
+        BOOST_OPENMETHOD_DEFAULT_REGISTRY>;
+
+    using classes = mp11::mp_unique<mp11::mp_append<
+        typename static_registry_classes<Classes>::type...>>;
+};
+
+// The classes in `Classes` that are, or derive from, `Class`. They form one
+// dimension of a static dispatch table.
+template<class Class, class Classes>
+using static_dimension =
+    mp11::mp_filter_q<mp11::mp_bind_front<std::is_base_of, Class>, Classes>;
+
+// `true` if `Class` carries its index in `StaticRegistry`, i.e. if the root of
+// its hierarchy derives from `inplace_vindex<Root, StaticRegistry>`.
+template<class StaticRegistry, class Class>
+constexpr bool has_static_vindex = std::is_same_v<
+    decltype(boost_openmethod_vindex(
+        std::declval<const Class&>(), std::declval<StaticRegistry*>())),
+    vindex_type>;
+
+// Maps the type ids of the classes of a static registry to their indexes. The
+// table is open-addressed, and at most half full, thus a lookup usually costs
+// one hash and one comparison. Type ids are hashed and compared via
+// `Rtti::type_index`, as the same class may have several type ids.
+template<class Rtti, class Classes>
+class static_class_hash;
+
+template<class Rtti, class... Classes>
+class static_class_hash<Rtti, mp11::mp_list<Classes...>> {
+    static constexpr std::size_t count = sizeof...(Classes);
+
+    static constexpr auto log2_size() -> std::size_t {
+        std::size_t bits = 1;
+
+        while ((std::size_t(1) << bits) < 2 * count) {
+            ++bits;
+        }
+
+        return bits;
+    }
+
+    static constexpr std::size_t size = std::size_t(1) << log2_size();
+    static constexpr std::size_t shift =
+        sizeof(std::size_t) * CHAR_BIT - log2_size();
+
+    using type_index_type =
+        decltype(Rtti::type_index(std::declval<type_id>()));
+
+    static auto hash(type_id type) -> std::size_t {
+        return (std::hash<type_index_type>()(Rtti::type_index(type)) *
+                std::size_t(0x9e3779b97f4a7c15ull)) >>
+            shift;
+    }
+
+    type_id types[size] = {};
+    std::size_t indexes[size] = {}; // index + 1; 0 for an empty slot
+
+  public:
+    static_class_hash() {
+        type_id types_by_index[] = {Rtti::template static_type<Classes>()...};
+
+        for (std::size_t index = 0; index < count; ++index) {
+            auto slot = hash(types_by_index[index]);
+
+            while (indexes[slot] != 0) {
+                slot = (slot + 1) & (size - 1);
+            }
+
+            types[slot] = types_by_index[index];
+            indexes[slot] = index + 1;
+        }
+    }
+
+    // Returns the index of a class, or the number of classes if the type is
+    // not found.
+    auto find(type_id type) const -> std::size_t {
+        for (auto slot = hash(type);; slot = (slot + 1) & (size - 1)) {
+            auto index = indexes[slot];
+
+            if (index == 0) {
+                return count;
+            }
+
+            if (Rtti::type_index(types[slot]) == Rtti::type_index(type)) {
+                return index - 1;
+            }
+        }
+    }
+};
+
+// The hash table of a static registry's classes. It is initialized before
+// `main`, not on first use, so lookups do not test a guard variable. Until
+// then, it is zero-initialized, i.e. empty.
+template<class Rtti, class Classes>
+inline const static_class_hash<Rtti, Classes> static_class_table;
+
+// The classes of a dimension that are accepted by the same overriders, in the
+// virtual parameter at position `D`, form a dispatch group: they select the
+// same overriders, whatever the other arguments. `classes` contains the first
+// class of each group, and `index<Class>` is the index of the group of
+// `Class`.
+template<class Class, class D>
+struct static_accepts {
+    template<class OverriderTypes>
+    using fn = std::is_base_of<mp11::mp_at<OverriderTypes, D>, Class>;
+};
+
+template<class OverriderTypes, class D, class Dimension>
+struct static_groups {
+    template<class Class>
+    using key = mp11::mp_transform_q<static_accepts<Class, D>, OverriderTypes>;
+
+    using keys = mp11::mp_transform<key, Dimension>;
+    using unique_keys = mp11::mp_unique<keys>;
+
+    template<class Key>
+    using first_class = mp11::mp_at<Dimension, mp11::mp_find<keys, Key>>;
+
+    using classes = mp11::mp_transform<first_class, unique_keys>;
+
+    template<class Class>
+    using index = mp11::mp_find<unique_keys, key<Class>>;
+};
+
+template<class Groups>
+using static_group_classes = typename Groups::classes;
+
+// The offset of the group of each class of a static registry in a dimension of
+// a dispatch table, premultiplied by the stride. The classes that are not in
+// the dimension cannot be the dynamic type of the corresponding argument,
+// their offset is not used.
+template<class Groups, class Dimension, std::size_t Stride, class Classes>
+struct static_dimension_offsets;
+
+template<
+    class Groups, class Dimension, std::size_t Stride, class... Classes>
+struct static_dimension_offsets<
+    Groups, Dimension, Stride, mp11::mp_list<Classes...>> {
+    static constexpr std::size_t value[] = {
+        (mp11::mp_contains<Dimension, Classes>::value
+             ? Groups::template index<Classes>::value * Stride
+             : 0)...};
+};
+
+// The classes of the dispatch table cell at position `Cell`. The first
+// dimension varies fastest.
+template<std::size_t Cell, class Dimensions>
+struct static_cell_classes {
+    using type = mp11::mp_list<>;
+};
+
+template<std::size_t Cell, class Dimension, class... MoreDimensions>
+struct static_cell_classes<
+    Cell, mp11::mp_list<Dimension, MoreDimensions...>> {
+    static constexpr std::size_t size = mp11::mp_size<Dimension>::value;
+
+    using type = mp11::mp_push_front<
+        typename static_cell_classes<
+            Cell / size, mp11::mp_list<MoreDimensions...>>::type,
+        mp11::mp_at_c<Dimension, Cell % size>>;
+};
+
+// The product of the sizes of the first `Dim` dimensions.
+template<class Dimensions, std::size_t Dim>
+constexpr std::size_t static_stride = static_stride<Dimensions, Dim - 1> *
+    mp11::mp_size<mp11::mp_at_c<Dimensions, Dim - 1>>::value;
+
+template<class Dimensions>
+constexpr std::size_t static_stride<Dimensions, 0> = 1;
+
+template<class Classes, class Class>
+struct static_class_vindex {
+    static_assert(
+        mp11::mp_contains<Classes, Class>::value,
+        "class is not in the static_registry");
+
+    static constexpr vindex_type value =
+        vindex_type(mp11::mp_find<Classes, Class>::value);
+};
+
+template<typename>
+struct static_overrider_parameters;
+
+template<typename ReturnType, typename... Parameters>
+struct static_overrider_parameters<ReturnType (*)(Parameters...)> {
+    using type = mp11::mp_list<Parameters...>;
+};
+
+// Overriders listed in the method's template arguments.
+template<auto... Overriders>
+struct static_overriders {
+    template<class DeclaredParameters, class Dimensions>
+    using fn = mp11::mp_list<
+        std::integral_constant<decltype(Overriders), Overriders>...>;
+};
+
+template<typename T, class Class>
+struct static_rebind;
+
+template<typename T, class Class>
+struct static_rebind<T&, Class> {
+    using type = std::conditional_t<std::is_const_v<T>, const Class, Class>&;
+};
+
+template<typename T, class Class>
+struct static_rebind<T&&, Class> {
+    using type = Class&&;
+};
+
+template<typename T, class Class>
+struct static_rebind<T*, Class> {
+    using type = std::conditional_t<std::is_const_v<T>, const Class, Class>*;
+};
+
+// The key of an overrider for `Classes`: `overrider_key` applied to the
+// method's parameters, with the virtual ones rebound to the classes.
+template<class Done, class Parameters, class Classes>
+struct static_overrider_key;
+
+template<typename... Done>
+struct static_overrider_key<
+    mp11::mp_list<Done...>, mp11::mp_list<>, mp11::mp_list<>> {
+    using type = overrider_key(Done...);
+};
+
+template<
+    typename... Done, typename Parameter, typename... MoreParameters,
+    class Classes>
+struct static_overrider_key<
+    mp11::mp_list<Done...>, mp11::mp_list<Parameter, MoreParameters...>,
+    Classes> {
+    using type = typename static_overrider_key<
+        mp11::mp_list<Done..., Parameter>, mp11::mp_list<MoreParameters...>,
+        Classes>::type;
+};
+
+template<
+    typename... Done, typename Parameter, typename... MoreParameters,
+    class Class, class... MoreClasses>
+struct static_overrider_key<
+    mp11::mp_list<Done...>,
+    mp11::mp_list<virtual_<Parameter>, MoreParameters...>,
+    mp11::mp_list<Class, MoreClasses...>> {
+    using type = typename static_overrider_key<
+        mp11::mp_list<Done..., typename static_rebind<Parameter, Class>::type>,
+        mp11::mp_list<MoreParameters...>, mp11::mp_list<MoreClasses...>>::type;
+};
+
+template<typename T, typename = void>
+struct static_overrider_declared : std::false_type {};
+
+template<typename T>
+struct static_overrider_declared<T, std::void_t<decltype(sizeof(T))>>
+    : std::true_type {};
+
+// Overriders defined with BOOST_OPENMETHOD_OVERRIDE. They are found by trying
+// all the combinations of classes in the dimensions of the method.
+template<class Id>
+struct static_macro_overriders {
+    using holder =
+        decltype(boost_openmethod_overriders(std::declval<Id*>()));
+
+    static_assert(
+        !std::is_same_v<holder, void>,
+        "methods in a static_registry must be declared with BOOST_OPENMETHOD, "
+        "or with static_registry::method");
+
+    template<class DeclaredParameters, class Classes>
+    using overrider = typename holder::template fn<
+        typename static_overrider_key<
+            mp11::mp_list<>, DeclaredParameters, Classes>::type>;
+
+    template<class DeclaredParameters>
+    struct is_declared {
+        template<class Classes>
+        using fn = static_overrider_declared<
+            overrider<DeclaredParameters, Classes>>;
+    };
+
+    template<class DeclaredParameters>
+    struct function {
+        template<class Classes>
+        using fn = std::integral_constant<
+            decltype(&overrider<DeclaredParameters, Classes>::type::fn),
+            &overrider<DeclaredParameters, Classes>::type::fn>;
+    };
+
+    template<class DeclaredParameters, class Dimensions>
+    using fn = mp11::mp_transform_q<
+        function<DeclaredParameters>,
+        mp11::mp_filter_q<
+            is_declared<DeclaredParameters>,
+            mp11::mp_apply<
+                mp11::mp_product_q,
+                mp11::mp_push_front<
+                    Dimensions, mp11::mp_quote<mp11::mp_list>>>>>;
+};
+
+// `true` if an overrider taking virtual types `A` is more specific than one
+// taking `B`.
+template<class A, class B>
+using static_more_specific = mp11::mp_and<
+    mp11::mp_apply<mp11::mp_all, mp11::mp_transform<std::is_base_of, B, A>>,
+    mp11::mp_not<std::is_same<A, B>>>;
+
+// `true` if the overrider at index `I` in `Overriders` accepts `Classes`.
+template<class Overriders, class Classes>
+struct static_applicable {
+    template<class I>
+    using fn = mp11::mp_apply<
+        mp11::mp_all,
+        mp11::mp_transform<
+            std::is_base_of, mp11::mp_at<Overriders, I>, Classes>>;
+};
+
+// `true` if the overrider at index `I` in `Overriders` is more specific than
+// the overrider at index `J`.
+template<class Overriders, class I>
+struct static_dominated {
+    template<class J>
+    using fn = static_more_specific<
+        mp11::mp_at<Overriders, I>, mp11::mp_at<Overriders, J>>;
+};
+
+// Selects the most specific overrider among `Candidates`, a list of indexes in
+// `Overriders`. `value` is the index of the overrider; or the number of
+// overriders if there is no candidate; or that number plus one if no
+// candidate is more specific than all the others.
+template<class Overriders, class Candidates>
+struct static_select {
+    template<class I>
+    struct dominates {
+        template<class J>
+        using fn = mp11::mp_or<
+            std::is_same<I, J>,
+            static_more_specific<
+                mp11::mp_at<Overriders, I>, mp11::mp_at<Overriders, J>>>;
+    };
+
+    template<class I>
+    using is_best = mp11::mp_all_of_q<Candidates, dominates<I>>;
+
+    static constexpr std::size_t value = mp11::mp_empty<Candidates>::value
+        ? mp11::mp_size<Overriders>::value
+        : mp11::mp_front<mp11::mp_push_back<
+              mp11::mp_filter<is_best, Candidates>,
+              mp11::mp_size_t<mp11::mp_size<Overriders>::value + 1>>>::value;
+};
+
+template<typename FunctionPointer, class TableDimensions, class Cells>
+struct static_table;
+
+template<typename FunctionPointer, class TableDimensions, std::size_t... Cells>
+struct static_table<
+    FunctionPointer, TableDimensions, std::index_sequence<Cells...>> {
+    template<class Method>
+    static constexpr FunctionPointer value[] = {Method::template select<
+        typename static_cell_classes<Cells, TableDimensions>::type>()...};
+};
+
+} // namespace detail
+
+//! A registry whose classes and methods are known at compile time.
+//!
+//! `static_registry` is an alternative to the registries built by @ref
+//! initialize, for closed hierarchies, where all the classes, methods and
+//! overriders are known in one translation unit. The classes are listed in
+//! `static_registry`'s template arguments, either directly, or grouped in
+//! @ref use_classes. Each class is given a dense index, its position in the
+//! list, as a constant expression. The dispatch tables are computed during
+//! compilation, and emitted as `constexpr` arrays of function pointers,
+//! indexed by the indexes of the classes of the virtual arguments.
+//!
+//! Thus there is no need to call `initialize`, and no run time cost at
+//! startup. Since the tables are constant, the compiler can also see through
+//! them, and optimize calls with known argument types.
+//!
+//! The methods are declared either with @ref static_registry::method, which
+//! takes the overriders as template arguments; or with @ref BOOST_OPENMETHOD,
+//! passing the static registry as the registry. In the latter case, the
+//! overriders are defined with @ref BOOST_OPENMETHOD_OVERRIDE, in the same
+//! namespace as the method, and they must return the method's return type.
+//! They are collected when the method is first called, or when `next` or
+//! `resolve` is used. Thus all the overriders must be declared before the
+//! method is used in a constant expression. @ref BOOST_OPENMETHOD_CLASSES, and
+//! `use_classes` naming a static registry, only check that the classes are in
+//! the registry.
+//!
+//! The last argument may be a @ref registry, which supplies the `rtti` and
+//! `error_handler` policies. It defaults to
+//! @ref BOOST_OPENMETHOD_DEFAULT_REGISTRY. Its classes and methods are not
+//! used, and it does not need to be initialized.
+//!
+//! @tparam Classes The classes, optionally followed by a registry.
+template<class... Classes>
+struct static_registry : detail::static_registry_base {
+    //! The index of a class.
+    //!
+    //! Objects of classes derived from `inplace_vindex<Root, static_registry>`
+    //! carry this index. The dynamic types of other classes are looked up in a
+    //! hash table, built before `main`.
+    //!
+    //! @tparam Class A class in the registry.
+    template<class Class>
+    static constexpr vindex_type static_vindex =
+        detail::static_class_vindex<
+            typename detail::static_registry_traits<static_registry>::classes,
+            Class>::value;
+
+    //! A method in this registry.
+    //!
+    //! @tparam Signature The signature of the method.
+    //! @tparam Overriders The overriders.
+    template<typename Signature, auto... Overriders>
+    using method = static_method<
+        static_registry, Signature, detail::static_overriders<Overriders...>>;
+};
+
+//! A method with a closed set of overriders, dispatched at compile time.
+//!
+//! The parameters follow the same rules as for @ref method, except that the
+//! virtual parameters must be references or pointers, decorated with
+//! `virtual_`. `virtual_ptr` is not supported, because it depends on the
+//! v-tables built by `initialize`.
+//!
+//! Each virtual parameter corresponds to one dimension of a dispatch table.
+//! As for @ref method, the classes in the registry that derive from the
+//! parameter's class are partitioned in dispatch groups: the classes that are
+//! accepted by the same overriders, in that parameter, select the same
+//! overriders whatever the other arguments, and share one position in the
+//! dimension. Each argument adds the offset of the group of its class to the
+//! address of the table. The offsets are stored, indexed by class index, and
+//! premultiplied by the compile-time strides, in one `constexpr` array per
+//! dimension. A cell contains a pointer to the most specific overrider; or to
+//! a function that signals a @ref not_implemented_error or an
+//! @ref ambiguous_error, via the error handler of the registry, then calls
+//! `abort`.
+//!
+//! The overriders defined with @ref BOOST_OPENMETHOD_OVERRIDE are found by
+//! trying the combinations of classes accepted by the virtual parameters,
+//! which takes time during compilation for methods with several virtual
+//! parameters. The overriders passed to @ref static_registry::method are
+//! not searched.
+//!
+//! The index of the dynamic type of an argument is read from the object if
+//! its class derives from `inplace_vindex<Root, StaticRegistry>`. It is not
+//! needed if the class of the parameter has no derived classes in the
+//! registry. Otherwise, it is looked up in a hash table, initialized before
+//! `main`; thus such methods cannot be called during static initialization.
+//! If the type is not found, an @ref unknown_class_error is signalled.
+//!
+//! @tparam StaticRegistry A @ref static_registry.
+//! @tparam Signature The signature of the method.
+//! @tparam Overriders Provides the overriders (implementation detail).
+template<
+    class StaticRegistry, typename ReturnType, typename... Parameters,
+    class Overriders>
+class static_method<StaticRegistry, ReturnType(Parameters...), Overriders> {
+    using Traits = detail::static_registry_traits<
+        typename StaticRegistry::static_registry>;
+    using Registry = typename Traits::registry;
+    using rtti = typename Registry::rtti;
+    using Classes = typename Traits::classes;
+    using DeclaredParameters = mp11::mp_list<Parameters...>;
+    using VirtualTypes = mp11::mp_transform_q<
+        mp11::mp_bind_back<detail::virtual_type, Registry>,
+        detail::virtual_types<DeclaredParameters>>;
+    using Dimensions = mp11::mp_transform_q<
+        mp11::mp_bind_back<detail::static_dimension, Classes>, VirtualTypes>;
+
+    static constexpr std::size_t Arity = mp11::mp_size<VirtualTypes>::value;
+
+    static_assert(Arity > 0, "method has no virtual parameters");
+    static_assert(
+        (!detail::is_virtual_ptr<Parameters> && ...),
+        "static methods do not support virtual_ptr parameters");
+    static_assert(
+        !mp11::mp_any_of<Dimensions, mp11::mp_empty>::value,
+        "the classes of the virtual parameters must be in the registry");
+
+    template<typename Parameter>
+    using forward_type = typename BOOST_OPENMETHOD_DETAIL_UNLESS_MRDOCS
+        StripVirtualDecorator<Parameter>::type;
+
+    // The overriders, computed when first needed, not when the class is
+    // instantiated: the overriders defined with BOOST_OPENMETHOD_OVERRIDE are
+    // declared after the method.
+    struct overriders {
+        using list = typename Overriders::template fn<
+            DeclaredParameters, Dimensions>;
+
+        template<class Overrider>
+        using overrider_virtual_types = detail::overrider_virtual_types<
+            DeclaredParameters,
+            typename detail::static_overrider_parameters<
+                typename Overrider::value_type>::type,
+            Registry>;
+
+        using virtual_types = mp11::mp_transform<overrider_virtual_types, list>;
+    };
+
+    // The dispatch table, also computed when first needed. Each dimension
+    // contains one class per dispatch group of the corresponding virtual
+    // parameter.
+    struct table {
+        template<class D>
+        using dimension_groups = detail::static_groups<
+            typename overriders::virtual_types, D, mp11::mp_at<Dimensions, D>>;
+
+        using groups = mp11::mp_transform<
+            dimension_groups, mp11::mp_iota_c<Arity>>;
+        using dimensions =
+            mp11::mp_transform<detail::static_group_classes, groups>;
+
+        static constexpr std::size_t cells =
+            detail::static_stride<dimensions, Arity>;
+
+        template<std::size_t D>
+        using offsets = detail::static_dimension_offsets<
+            mp11::mp_at_c<groups, D>, mp11::mp_at_c<Dimensions, D>,
+            detail::static_stride<dimensions, D>, Classes>;
+    };
+
+  public:
+    //! The type of a pointer to an overrider, after the arguments have been
+    //! cast to the overriders' parameter types.
+    using FunctionPointer =
+        auto (*)(detail::remove_virtual_<Parameters>...) -> ReturnType;
+
+  private:
+    template<
+        auto Overrider,
+        typename OverriderType = std::remove_cv_t<decltype(Overrider)>>
+    struct thunk;
+
+    template<
+        auto Overrider, typename OverriderReturn,
+        typename... OverriderParameters>
+    struct thunk<Overrider, OverriderReturn (*)(OverriderParameters...)> {
+        static auto fn(detail::remove_virtual_<Parameters>... arg)
+            -> ReturnType {
+            return Overrider(
+                detail::parameter_traits<Parameters, Registry>::template cast<
+                    OverriderParameters>(
+                    std::forward<detail::remove_virtual_<Parameters>>(
+                        arg))...);
+        }
+    };
+
+    template<typename, class, class>
+    friend struct detail::static_table;
+
+    template<class Candidates>
+    static constexpr auto select_overrider() -> FunctionPointer;
+
+    template<class CellClasses>
+    static constexpr auto select() -> FunctionPointer {
+        return select_overrider<mp11::mp_filter_q<
+            detail::static_applicable<
+                typename overriders::virtual_types, CellClasses>,
+            mp11::mp_iota<mp11::mp_size<typename overriders::list>>>>();
+    }
+
+    template<std::size_t Dim, typename ArgType>
+    static auto class_index(const ArgType& arg) -> std::size_t;
+
+    template<
+        std::size_t VirtualArg, typename MethodArgList, typename ArgType,
+        typename... MoreArgTypes>
+    static auto resolve_next(
+        const FunctionPointer* dispatch, const ArgType& arg,
+        const MoreArgTypes&... more_args) -> FunctionPointer;
+
+    BOOST_NORETURN static auto
+    fn_not_implemented(detail::remove_virtual_<Parameters>... args)
+        -> ReturnType;
+    BOOST_NORETURN static auto
+    fn_ambiguous(detail::remove_virtual_<Parameters>... args) -> ReturnType;
+
+  public:
+    //! Call the method.
+    //!
+    //! Look up the indexes of the dynamic types of the virtual arguments,
+    //! fetch the corresponding cell in the dispatch table, and call the
+    //! function it points to.
+    //!
+    //! @param args The arguments for the method call.
+    //! @return The value returned by the overrider.
+    static auto fn(forward_type<Parameters>... args) -> ReturnType;
+
+    //! Return the overrider for a combination of classes.
+    //!
+    //! The result is a constant expression.
+    //!
+    //! @tparam Classes The dynamic types of the virtual arguments.
+    //! @return A pointer to the function that the method would call.
+    template<class... CallClasses>
+    static constexpr auto resolve() -> FunctionPointer {
+        static_assert(
+            sizeof...(CallClasses) == Arity, "wrong number of classes");
+
+        return select<mp11::mp_list<CallClasses...>>();
+    }
+
+    //! Pointer to next most specialized overrider.
+    //!
+    //! As for @ref method::next, but computed at compile time.
+    //!
+    //! @tparam Overrider One of the overriders.
+    template<auto Overrider>
+    static constexpr FunctionPointer next =
+        select_overrider<mp11::mp_filter_q<
+            detail::static_dominated<
+                typename overriders::virtual_types,
+                mp11::mp_find<
+                    typename overriders::list,
+                    std::integral_constant<decltype(Overrider), Overrider>>>,
+            mp11::mp_iota<mp11::mp_size<typename overriders::list>>>>();
+
+    //! Check if a next most specialized overrider exists.
+    //!
+    //! As for @ref method::has_next. It is not a constant expression, so that
+    //! the overriders defined with BOOST_OPENMETHOD_OVERRIDE can call it
+    //! before the method's other overriders are declared.
+    //!
+    //! @tparam Overrider One of the overriders.
+    //! @return `true` if a next most specialized overrider exists.
+    template<auto Overrider>
+    static auto has_next() -> bool {
+        return next<Overrider> != fn_not_implemented &&
+            next<Overrider> != fn_ambiguous;
+    }
+};
+
+template<
+    class StaticRegistry, typename ReturnType, typename... Parameters,
+    class Overriders>
+template<class Candidates>
+constexpr auto
+static_method<StaticRegistry, ReturnType(Parameters...), Overriders>::
+    select_overrider() -> FunctionPointer {
+    using list = typename overriders::list;
+
+    constexpr auto index = detail::static_select<
+        typename overriders::virtual_types, Candidates>::value;
+
+    if constexpr (index < mp11::mp_size<list>::value) {
+        return thunk<mp11::mp_at_c<list, index>::value>::fn;
+    } else if constexpr (index == mp11::mp_size<list>::value) {
+        return fn_not_implemented;
+    } else {
+        return fn_ambiguous;
+    }
+}
+
+template<
+    class StaticRegistry, typename ReturnType, typename... Parameters,
+    class Overriders>
+template<std::size_t Dim, typename ArgType>
+BOOST_FORCEINLINE auto
+static_method<StaticRegistry, ReturnType(Parameters...), Overriders>::
+    class_index(const ArgType& arg) -> std::size_t {
+    using Dimension = mp11::mp_at_c<Dimensions, Dim>;
+
+    if constexpr (mp11::mp_size<Dimension>::value == 1) {
+        return StaticRegistry::template static_vindex<
+            mp11::mp_front<Dimension>>;
+    } else if constexpr (detail::has_static_vindex<StaticRegistry, ArgType>) {
+        return boost_openmethod_vindex(
+            arg, static_cast<StaticRegistry*>(nullptr));
+    } else {
+        static_assert(
+            rtti::template is_polymorphic<ArgType>,
+            "virtual parameters with subclasses must be polymorphic");
+
+        auto type = rtti::template dynamic_type<ArgType>(arg);
+        auto index = detail::static_class_table<rtti, Classes>.find(type);
+
+        if (index == mp11::mp_size<Classes>::value) {
+            if constexpr (Registry::has_error_handler) {
+                unknown_class_error error;
+                error.type = type;
+                Registry::error_handler::error(error);
+            }
+
+            abort();
+        }
+
+        return index;
+    }
+}
+
+template<
+    class StaticRegistry, typename ReturnType, typename... Parameters,
+    class Overriders>
+template<
+    std::size_t VirtualArg, typename MethodArgList, typename ArgType,
+    typename... MoreArgTypes>
+BOOST_FORCEINLINE auto
+static_method<StaticRegistry, ReturnType(Parameters...), Overriders>::
+    resolve_next(
+        const FunctionPointer* dispatch, const ArgType& arg,
+        const MoreArgTypes&... more_args) -> FunctionPointer {
+    if constexpr (detail::is_virtual<mp11::mp_first<MethodArgList>>::value) {
+        constexpr auto& offsets =
+            table::template offsets<VirtualArg>::value;
+
+        dispatch = dispatch + offsets[class_index<VirtualArg>(arg)];
+
+        if constexpr (VirtualArg + 1 == Arity) {
+            return *dispatch;
+        } else {
+            return resolve_next<VirtualArg + 1, mp11::mp_rest<MethodArgList>>(
+                dispatch, more_args...);
+        }
+    } else {
+        // Non-virtual parameters don't count.
+        return resolve_next<VirtualArg, mp11::mp_rest<MethodArgList>>(
+            dispatch, more_args...);
+    }
+}
+
+template<
+    class StaticRegistry, typename ReturnType, typename... Parameters,
+    class Overriders>
+BOOST_FORCEINLINE auto
+static_method<StaticRegistry, ReturnType(Parameters...), Overriders>::fn(
+    forward_type<Parameters>... args) -> ReturnType {
+    constexpr auto& cells =
+        detail::static_table<FunctionPointer, typename table::dimensions,
+                             std::make_index_sequence<table::cells>>::
+            template value<static_method>;
+
+    auto pf = resolve_next<0, DeclaredParameters>(
+        cells, detail::parameter_traits<Parameters, Registry>::peek(args)...);
+
+    return pf(std::forward<forward_type<Parameters>>(args)...);
+}
+
+template<
+    class StaticRegistry, typename ReturnType, typename... Parameters,
+    class Overriders>
+BOOST_NORETURN auto
+static_method<StaticRegistry, ReturnType(Parameters...), Overriders>::
+    fn_not_implemented(detail::remove_virtual_<Parameters>... args)
+        -> ReturnType {
+    if constexpr (Registry::has_error_handler) {
+        not_implemented_error error;
+        detail::init_call_error<static_method, rtti, 0u>::fn(
+            error,
+            detail::parameter_traits<Parameters, Registry>::peek(args)...);
+        Registry::error_handler::error(error);
+    }
+
+    abort();
+}
+
+template<
+    class StaticRegistry, typename ReturnType, typename... Parameters,
+    class Overriders>
+BOOST_NORETURN auto
+static_method<StaticRegistry, ReturnType(Parameters...), Overriders>::
+    fn_ambiguous(detail::remove_virtual_<Parameters>... args) -> ReturnType {
+    if constexpr (Registry::has_error_handler) {
+        ambiguous_error error;
+        detail::init_call_error<static_method, rtti, 0u>::fn(
+            error,
+            detail::parameter_traits<Parameters, Registry>::peek(args)...);
+        Registry::error_handler::error(error);
+    }
+
+    abort();
+}
+
+//! A method declared with @ref BOOST_OPENMETHOD in a @ref static_registry.
+//!
+//! The overriders are the ones defined with @ref BOOST_OPENMETHOD_OVERRIDE
+//! for the method. They are found during compilation, see @ref
+//! static_registry.
+//!
+//! @tparam Id A type representing the method's name.
+//! @tparam ReturnType The return type of the method.
+//! @tparam Parameters The types of the parameters.
+//! @tparam Classes The template arguments of the static registry.
+template<
+    typename Id, typename... Parameters, typename ReturnType,
+    class... Classes>
+class method<Id, ReturnType(Parameters...), static_registry<Classes...>>
+    : public static_method<
+          static_registry<Classes...>, ReturnType(Parameters...),
+          detail::static_macro_overriders<Id>> {
+  public:
+    //! Does nothing.
+    //!
+    //! The overriders of a static method are not registered at run time.
+    //! `override` exists for the benefit of @ref BOOST_OPENMETHOD_OVERRIDE.
+    //!
+    //! @tparam Fn Overriders.
+    template<auto... Fn>
+    struct override {
+        override() {
+        }
+
+        ~override() {
+        }
+    };
+};
+
+} // namespace boost::openmethod
+
+#endif
@@ -0,0 +1,198 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Microbenchmark for the layout of the methods' slots: call many distinct
+// methods in a loop, first with the data in the caches, then with the caches
+// flushed before each round of calls.
+//
+// "library" calls the methods. "scattered" and "colocated" dispatch by hand,
+// reading the slot of each method from a per-method static variable - the
+// layout of the library - or via a per-method pointer into one cache-aligned
+// block allocated at run time - the layout of a colocated_slots policy, which
+// the library does not provide, because it is not faster.
+//
+// Built with the tests, but not run by them: it checks nothing. Build with -O3
+// -DNDEBUG for meaningful timings.
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+using namespace boost::openmethod;
+
+constexpr std::size_t method_count = 16;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat);
+
+auto poke_animal(const Animal&) -> int {
+    return 1;
+}
+
+auto poke_dog(const Dog&) -> int {
+    return 2;
+}
+
+template<std::size_t N>
+struct poke_id;
+
+template<std::size_t N>
+using poke =
+    method<poke_id<N>, auto(virtual_<const Animal&>)->int, default_registry>;
+
+// The slot of each method, at a fixed address, as in the library.
+template<std::size_t N>
+std::size_t scattered_slot;
+
+// A pointer to the slot of each method in a single block, as stored in the
+// method object by a colocated layout.
+template<std::size_t N>
+const std::size_t* colocated_slot;
+
+using thunk_type = auto (*)(const Animal&) -> int;
+
+template<std::size_t N>
+inline auto call_scattered(const Animal& animal) -> int {
+    auto vptr = default_registry::policy<policies::vptr>::dynamic_vptr(animal);
+
+    return reinterpret_cast<thunk_type>(vptr[scattered_slot<N>].pf)(animal);
+}
+
+template<std::size_t N>
+inline auto call_colocated(const Animal& animal) -> int {
+    auto vptr = default_registry::policy<policies::vptr>::dynamic_vptr(animal);
+
+    return reinterpret_cast<thunk_type>(vptr[*colocated_slot<N>].pf)(animal);
+}
+
+template<class Indices = std::make_index_sequence<method_count>>
+struct pokes;
+
+template<std::size_t... N>
+struct pokes<std::index_sequence<N...>> {
+    std::tuple<typename poke<N>::template override<poke_animal, poke_dog>...>
+        overriders;
+
+    static auto copy_slots(std::size_t* block) -> void {
+        ((scattered_slot<N> = poke<N>::fn.slots_strides_ptr[0]), ...);
+        ((block[N] = poke<N>::fn.slots_strides_ptr[0]), ...);
+        ((colocated_slot<N> = &block[N]), ...);
+    }
+
+    static auto call_library(const std::vector<Animal*>& animals) -> long {
+        long sum = 0;
+
+        for (auto animal : animals) {
+            sum += (poke<N>::fn(*animal) + ...);
+        }
+
+        return sum;
+    }
+
+    static auto call_scattered(const std::vector<Animal*>& animals) -> long {
+        long sum = 0;
+
+        for (auto animal : animals) {
+            sum += (::call_scattered<N>(*animal) + ...);
+        }
+
+        return sum;
+    }
+
+    static auto call_colocated(const std::vector<Animal*>& animals) -> long {
+        long sum = 0;
+
+        for (auto animal : animals) {
+            sum += (::call_colocated<N>(*animal) + ...);
+        }
+
+        return sum;
+    }
+};
+
+BOOST_OPENMETHOD_REGISTER(pokes<>);
+
+template<typename Fn>
+void measure(const char* label, Fn fn, const std::vector<Animal*>& animals) {
+    constexpr int repeat = 1000;
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < repeat; ++i) {
+        sum += fn(animals);
+    }
+
+    auto elapsed = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start);
+    auto calls = double(repeat) * animals.size() * method_count;
+
+    std::cout << label << ": " << elapsed.count() / calls << " ns/call ("
+              << sum << ")\n";
+}
+
+// Evicts the slots from the caches before each round of calls, and times only
+// the calls.
+template<typename Fn>
+void measure_cold(const char* label, Fn fn, const std::vector<Animal*>& one) {
+    constexpr int repeat = 1000;
+    static std::vector<char> evict(64 << 20);
+    long sum = 0;
+    std::chrono::duration<double, std::nano> elapsed{0};
+
+    for (int i = 0; i < repeat; ++i) {
+        for (std::size_t j = 0; j < evict.size(); j += 64) {
+            ++evict[j];
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        sum += fn(one);
+        elapsed += std::chrono::steady_clock::now() - start;
+    }
+
+    std::cout << label << ": " << elapsed.count() / (repeat * method_count)
+              << " ns/call (" << sum << ")\n";
+}
+
+auto main() -> int {
+    initialize();
+
+    struct alignas(64) slot_block {
+        std::size_t slots[method_count];
+    };
+
+    auto block = std::make_unique<slot_block>();
+    pokes<>::copy_slots(block->slots);
+
+    Dog dog;
+    Cat cat;
+    std::vector<Animal*> animals;
+
+    for (int i = 0; i < 1000; ++i) {
+        animals.push_back(i % 3 ? static_cast<Animal*>(&dog) : &cat);
+    }
+
+    measure("library", pokes<>::call_library, animals);
+    measure("scattered", pokes<>::call_scattered, animals);
+    measure("colocated", pokes<>::call_colocated, animals);
+
+    std::vector<Animal*> one{&dog};
+    measure_cold("library, cold", pokes<>::call_library, one);
+    measure_cold("scattered, cold", pokes<>::call_scattered, one);
+    measure_cold("colocated, cold", pokes<>::call_colocated, one);
+}
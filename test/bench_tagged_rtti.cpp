@@ -0,0 +1,153 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Microbenchmark for the tagged_rtti policy: call a uni-method and a
+// multi-method via plain references, with the vptrs obtained from std_rtti and
+// fast_perfect_hash, then from dense tags. Built with the tests, but not run
+// by them: it checks nothing. Build with -O3 -DNDEBUG for meaningful timings.
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/tagged_rtti.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal : tagged<Animal> {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : tagged<Dog, Animal> {};
+struct Cat : tagged<Cat, Animal> {};
+struct Bird : tagged<Bird, Animal> {};
+
+using std_registry = default_registry;
+using tagged_registry = default_registry::with<policies::tagged_rtti>::without<
+    policies::type_hash, policies::runtime_checks>;
+
+auto poke_animal(const Animal&) -> int {
+    return 1;
+}
+
+auto poke_dog(const Dog&) -> int {
+    return 2;
+}
+
+auto meet_animals(const Animal&, const Animal&) -> int {
+    return 1;
+}
+
+auto meet_dog_cat(const Dog&, const Cat&) -> int {
+    return 2;
+}
+
+template<class Poke>
+auto call_poke(const std::vector<Animal*>& animals) -> long {
+    long sum = 0;
+
+    for (auto animal : animals) {
+        sum += Poke::fn(*animal);
+    }
+
+    return sum;
+}
+
+template<class Meet>
+auto call_meet(const std::vector<Animal*>& animals) -> long {
+    long sum = 0;
+
+    for (std::size_t i = 1; i < animals.size(); ++i) {
+        sum += Meet::fn(*animals[i - 1], *animals[i]);
+    }
+
+    return sum;
+}
+
+namespace with_std_rtti {
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, Bird, std_registry);
+
+struct BOOST_OPENMETHOD_ID(poke);
+using poke = method<
+    BOOST_OPENMETHOD_ID(poke), auto(virtual_<const Animal&>)->int,
+    std_registry>;
+
+BOOST_OPENMETHOD_REGISTER(poke::override<poke_animal, poke_dog>);
+
+struct BOOST_OPENMETHOD_ID(meet);
+using meet = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->int, std_registry>;
+
+BOOST_OPENMETHOD_REGISTER(meet::override<meet_animals, meet_dog_cat>);
+
+} // namespace with_std_rtti
+
+namespace with_tagged_rtti {
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, Bird, tagged_registry);
+
+struct BOOST_OPENMETHOD_ID(poke);
+using poke = method<
+    BOOST_OPENMETHOD_ID(poke), auto(virtual_<const Animal&>)->int,
+    tagged_registry>;
+
+BOOST_OPENMETHOD_REGISTER(poke::override<poke_animal, poke_dog>);
+
+struct BOOST_OPENMETHOD_ID(meet);
+using meet = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->int,
+    tagged_registry>;
+
+BOOST_OPENMETHOD_REGISTER(meet::override<meet_animals, meet_dog_cat>);
+
+} // namespace with_tagged_rtti
+
+template<typename Fn>
+void measure(const char* label, Fn fn, const std::vector<Animal*>& animals) {
+    constexpr int repeat = 10000;
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < repeat; ++i) {
+        sum += fn(animals);
+    }
+
+    auto elapsed = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start);
+    auto calls = double(repeat) * animals.size();
+
+    std::cout << label << ": " << elapsed.count() / calls << " ns/call ("
+              << sum << ")\n";
+}
+
+auto main() -> int {
+    std_registry::initialize();
+    tagged_registry::initialize();
+
+    Dog dog;
+    Cat cat;
+    Bird bird;
+    std::vector<Animal*> animals;
+
+    for (int i = 0; i < 1000; ++i) {
+        Animal* choices[] = {&dog, &cat, &bird};
+        animals.push_back(choices[i * 7 % 3]);
+    }
+
+    measure("uni-method, std_rtti", call_poke<with_std_rtti::poke>, animals);
+    measure(
+        "uni-method, tagged_rtti", call_poke<with_tagged_rtti::poke>, animals);
+    measure(
+        "multi-method, std_rtti", call_meet<with_std_rtti::meet>, animals);
+    measure(
+        "multi-method, tagged_rtti", call_meet<with_tagged_rtti::meet>,
+        animals);
+}
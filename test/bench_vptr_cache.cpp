@@ -0,0 +1,146 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Microbenchmark for the vptr_cache policy: call a uni-method via plain
+// references, on homogeneous batches of objects, with and without a cache in
+// front of vptr_vector with runtime checks, and of vptr_map. Built with the
+// tests, but not run by them: it checks nothing. Build with -O3 -DNDEBUG for
+// meaningful timings.
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/vptr_map.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+struct Bird : Animal {};
+
+using vector_registry = default_registry::with<policies::runtime_checks>;
+using cached_vector_registry = vector_registry::with<policies::vptr_cache>;
+using map_registry = default_registry::with<policies::vptr_map<>>;
+using cached_map_registry = map_registry::with<policies::vptr_cache>;
+
+auto poke_animal(const Animal&) -> int {
+    return 1;
+}
+
+auto poke_dog(const Dog&) -> int {
+    return 2;
+}
+
+template<class Poke>
+auto call_poke(const std::vector<Animal*>& animals) -> long {
+    long sum = 0;
+
+    for (auto animal : animals) {
+        sum += Poke::fn(*animal);
+    }
+
+    return sum;
+}
+
+namespace with_vector {
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, Bird, vector_registry);
+
+struct BOOST_OPENMETHOD_ID(poke);
+using poke = method<
+    BOOST_OPENMETHOD_ID(poke), auto(virtual_<const Animal&>)->int,
+    vector_registry>;
+
+BOOST_OPENMETHOD_REGISTER(poke::override<poke_animal, poke_dog>);
+
+} // namespace with_vector
+
+namespace with_cached_vector {
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, Bird, cached_vector_registry);
+
+struct BOOST_OPENMETHOD_ID(poke);
+using poke = method<
+    BOOST_OPENMETHOD_ID(poke), auto(virtual_<const Animal&>)->int,
+    cached_vector_registry>;
+
+BOOST_OPENMETHOD_REGISTER(poke::override<poke_animal, poke_dog>);
+
+} // namespace with_cached_vector
+
+namespace with_map {
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, Bird, map_registry);
+
+struct BOOST_OPENMETHOD_ID(poke);
+using poke = method<
+    BOOST_OPENMETHOD_ID(poke), auto(virtual_<const Animal&>)->int,
+    map_registry>;
+
+BOOST_OPENMETHOD_REGISTER(poke::override<poke_animal, poke_dog>);
+
+} // namespace with_map
+
+namespace with_cached_map {
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, Bird, cached_map_registry);
+
+struct BOOST_OPENMETHOD_ID(poke);
+using poke = method<
+    BOOST_OPENMETHOD_ID(poke), auto(virtual_<const Animal&>)->int,
+    cached_map_registry>;
+
+BOOST_OPENMETHOD_REGISTER(poke::override<poke_animal, poke_dog>);
+
+} // namespace with_cached_map
+
+template<typename Fn>
+void measure(const char* label, Fn fn, const std::vector<Animal*>& animals) {
+    constexpr int repeat = 10000;
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < repeat; ++i) {
+        sum += fn(animals);
+    }
+
+    auto elapsed = std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now() - start);
+    auto calls = double(repeat) * animals.size();
+
+    std::cout << label << ": " << elapsed.count() / calls << " ns/call ("
+              << sum << ")\n";
+}
+
+auto main() -> int {
+    vector_registry::initialize();
+    cached_vector_registry::initialize();
+    map_registry::initialize();
+    cached_map_registry::initialize();
+
+    Dog dog;
+    Cat cat;
+    Bird bird;
+    std::vector<Animal*> animals;
+
+    // Three batches of 300 objects of the same class.
+    for (Animal* animal : {(Animal*)&dog, (Animal*)&cat, (Animal*)&bird}) {
+        animals.insert(animals.end(), 300, animal);
+    }
+
+    measure("vptr_vector", call_poke<with_vector::poke>, animals);
+    measure(
+        "vptr_vector, cached", call_poke<with_cached_vector::poke>, animals);
+    measure("vptr_map", call_poke<with_map::poke>, animals);
+    measure("vptr_map, cached", call_poke<with_cached_map::poke>, animals);
+}
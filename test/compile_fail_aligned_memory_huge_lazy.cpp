@@ -0,0 +1,28 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/aligned_memory.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+using namespace boost::openmethod;
+
+struct huge_lazy_registry
+    : default_registry::with<
+          policies::aligned_memory_options<
+              64, policies::page_kind::transparent_huge>,
+          policies::lazy_dispatch> {};
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+BOOST_OPENMETHOD_CLASSES(Animal, huge_lazy_registry);
+
+int main() {
+    huge_lazy_registry::initialize();
+    return 0;
+}
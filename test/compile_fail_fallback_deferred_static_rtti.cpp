@@ -0,0 +1,29 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+using namespace boost::openmethod;
+
+struct deferred_rtti : policies::deferred_static_rtti {
+    template<class Registry>
+    struct fn : policies::std_rtti::fn<Registry> {};
+};
+
+struct fallback_registry : default_registry::with<
+                               deferred_rtti, policies::fallback_dispatch> {};
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+BOOST_OPENMETHOD_CLASSES(Animal, fallback_registry);
+
+int main() {
+    fallback_registry::initialize();
+    return 0;
+}
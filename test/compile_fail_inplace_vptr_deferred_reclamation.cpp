@@ -0,0 +1,21 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/inplace_vptr.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+using namespace boost::openmethod;
+
+struct deferred_registry
+    : default_registry::with<policies::deferred_reclamation> {};
+
+struct Animal : inplace_vptr<Animal, deferred_registry> {};
+
+int main() {
+    deferred_registry::initialize();
+    Animal animal;
+    return 0;
+}
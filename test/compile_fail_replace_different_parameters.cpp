@@ -0,0 +1,33 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+struct Cat : Animal {};
+struct Dog : Animal {};
+
+struct BOOST_OPENMETHOD_ID(poke);
+using poke = method<
+    BOOST_OPENMETHOD_ID(poke), auto(virtual_<Animal&>)->void,
+    BOOST_OPENMETHOD_DEFAULT_REGISTRY>;
+
+void poke_cat(Cat&) {
+}
+
+void poke_dog(Dog&) {
+}
+
+BOOST_OPENMETHOD_REGISTER(poke::override<poke_cat>);
+
+int main() {
+    poke::replace<poke_cat, poke_dog>();
+    return 0;
+}
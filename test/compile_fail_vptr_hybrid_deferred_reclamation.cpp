@@ -0,0 +1,26 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/vptr_hybrid.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+using namespace boost::openmethod;
+
+struct hybrid_registry : default_registry::with<
+                             policies::vptr_hybrid<>,
+                             policies::deferred_reclamation> {};
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+BOOST_OPENMETHOD_CLASSES(Animal, hybrid_registry);
+
+int main() {
+    hybrid_registry::initialize();
+    return 0;
+}
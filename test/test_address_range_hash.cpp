@@ -0,0 +1,130 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/address_range_hash.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE address_range_hash
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+// Mimics the IdsToVptr objects passed by initialize.
+struct ids_to_vptr {
+    type_id id;
+
+    auto type_id_begin() const -> const type_id* {
+        return &id;
+    }
+
+    auto type_id_end() const -> const type_id* {
+        return &id + 1;
+    }
+};
+
+template<typename T>
+auto make_ids(T* first, std::size_t n) {
+    std::vector<ids_to_vptr> ids;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        ids.push_back({first + i});
+    }
+
+    return ids;
+}
+
+struct hash_registry
+    : test_registry_<__COUNTER__, policies::address_range_hash> {};
+
+using hash = hash_registry::policy<policies::type_hash>;
+
+BOOST_AUTO_TEST_CASE(dense_range) {
+    static char bytes[5];
+    auto ids = make_ids(bytes, 5);
+    auto [min_value, max_value] = hash::initialize(ids.begin(), ids.end());
+
+    BOOST_TEST(min_value == 0u);
+    BOOST_TEST(max_value == 4u);
+
+    for (std::size_t i = 0; i < 5; ++i) {
+        BOOST_TEST(hash::hash(&bytes[i]) == i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(aligned_range) {
+    // The common low bits are shifted out.
+    static std::uint64_t words[5];
+    auto ids = make_ids(words + 0, 5);
+    auto [min_value, max_value] = hash::initialize(ids.begin(), ids.end());
+
+    BOOST_TEST(min_value == 0u);
+    BOOST_TEST(max_value == 4u);
+
+    for (std::size_t i = 0; i < 5; ++i) {
+        BOOST_TEST(hash::hash(&words[i]) == i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(sparse_range) {
+    // Too sparse: uses fast_perfect_hash.
+    static char bytes[4096];
+    std::vector<ids_to_vptr> ids{
+        {&bytes[0]}, {&bytes[1]}, {&bytes[1000]}, {&bytes[4000]}};
+    auto [min_value, max_value] = hash::initialize(ids.begin(), ids.end());
+
+    std::vector<std::size_t> indexes;
+
+    for (auto& id : ids) {
+        auto index = hash::hash(id.id);
+        BOOST_TEST(index >= min_value);
+        BOOST_TEST(index <= max_value);
+        BOOST_TEST(
+            (std::find(indexes.begin(), indexes.end(), index) ==
+             indexes.end()));
+        indexes.push_back(index);
+    }
+}
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+struct test_registry : test_registry_<
+                           __COUNTER__, policies::address_range_hash,
+                           policies::runtime_checks> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+BOOST_OPENMETHOD(poke, (virtual_<const Animal&>), std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(poke, (const Dog&), std::string) {
+    return "bark";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(poke, (const Cat&), std::string) {
+    return "hiss";
+}
+
+BOOST_AUTO_TEST_CASE(dispatch) {
+    test_registry::initialize();
+
+    Dog dog;
+    Cat cat;
+
+    BOOST_TEST(poke(dog) == "bark");
+    BOOST_TEST(poke(cat) == "hiss");
+}
@@ -0,0 +1,199 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/aligned_memory.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE aligned_memory
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+auto name_animal(const Animal&) -> std::string {
+    return "animal";
+}
+
+auto name_dog(const Dog&) -> std::string {
+    return "dog";
+}
+
+auto meet_animals(const Animal&, const Animal&) -> std::string {
+    return "ignore";
+}
+
+auto meet_dog_cat(const Dog&, const Cat&) -> std::string {
+    return "chase";
+}
+
+template<class Registry>
+auto alignment() {
+    auto address = std::uintptr_t(Registry::static_vptrs.data());
+    return address & -address;
+}
+
+namespace cache_lines {
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::aligned_memory_options<128>> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(name);
+using name = method<
+    BOOST_OPENMETHOD_ID(name), auto(virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(name::override<name_animal, name_dog>);
+
+struct BOOST_OPENMETHOD_ID(meet);
+using meet = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(meet::override<meet_animals, meet_dog_cat>);
+
+BOOST_AUTO_TEST_CASE(cache_line_aligned) {
+    test_registry::initialize();
+    BOOST_TEST(alignment<test_registry>() >= 128u);
+
+    Dog dog;
+    Cat cat;
+
+    BOOST_TEST(name::fn(dog) == "dog");
+    BOOST_TEST(name::fn(cat) == "animal");
+    BOOST_TEST(meet::fn(dog, cat) == "chase");
+    BOOST_TEST(meet::fn(cat, dog) == "ignore");
+
+    test_registry::finalize();
+}
+
+} // namespace cache_lines
+
+namespace huge_pages {
+
+struct test_registry
+    : test_registry_<
+          __COUNTER__,
+          policies::aligned_memory_options<
+              64, policies::page_kind::transparent_huge, true>> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(name);
+using name = method<
+    BOOST_OPENMETHOD_ID(name), auto(virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(name::override<name_animal, name_dog>);
+
+struct BOOST_OPENMETHOD_ID(meet);
+using meet = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(meet::override<meet_animals, meet_dog_cat>);
+
+BOOST_AUTO_TEST_CASE(huge_page_aligned) {
+    test_registry::initialize();
+
+#ifdef __linux__
+    BOOST_TEST(alignment<test_registry>() >= (2u << 20));
+#endif
+
+    Dog dog;
+    Cat cat;
+
+    BOOST_TEST(name::fn(dog) == "dog");
+    BOOST_TEST(meet::fn(dog, cat) == "chase");
+
+    // Initialize again, the previous tables are unmapped.
+    test_registry::initialize();
+    BOOST_TEST(meet::fn(dog, cat) == "chase");
+
+    test_registry::finalize();
+}
+
+} // namespace huge_pages
+
+namespace lock_failures {
+
+struct capture_output : policies::output {
+    template<class Registry>
+    struct fn {
+        inline static std::ostringstream os;
+    };
+};
+
+struct test_registry
+    : test_registry_<
+          __COUNTER__, capture_output,
+          policies::aligned_memory_options<
+              64, policies::page_kind::normal, true>> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(name);
+using name = method<
+    BOOST_OPENMETHOD_ID(name), auto(virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(name::override<name_animal, name_dog>);
+
+BOOST_AUTO_TEST_CASE(lock_failures_are_reported) {
+    using memory = test_registry::policy<policies::dispatch_memory>;
+
+#ifdef __linux__
+    // Make mlock fail, unless the process is privileged.
+    rlimit old_limit;
+    getrlimit(RLIMIT_MEMLOCK, &old_limit);
+    rlimit no_lock = old_limit;
+    no_lock.rlim_cur = 0;
+    setrlimit(RLIMIT_MEMLOCK, &no_lock);
+#endif
+
+    test_registry::trace::on = true;
+    test_registry::initialize();
+    test_registry::trace::on = false;
+
+#ifdef __linux__
+    setrlimit(RLIMIT_MEMLOCK, &old_limit);
+#endif
+
+    auto trace = test_registry::output::os.str();
+    BOOST_TEST(
+        (memory::lock_failures() == 0) ==
+        (trace.find("mlock of ") == std::string::npos));
+
+    // The tables are populated even if they are not locked.
+    Dog dog;
+    Cat cat;
+    BOOST_TEST(name::fn(dog) == "dog");
+    BOOST_TEST(name::fn(cat) == "animal");
+
+    test_registry::finalize();
+}
+
+} // namespace lock_failures
@@ -0,0 +1,199 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/call_counters.hpp>
+#include <boost/openmethod/policies/throw_error_handler.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE call_counters
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+struct test_registry
+    : test_registry_<
+          __COUNTER__, policies::call_counters,
+          policies::throw_error_handler> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(poke);
+using poke = method<
+    BOOST_OPENMETHOD_ID(poke), auto(virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+auto poke_dog(const Dog&) -> std::string {
+    return "bark";
+}
+
+auto poke_cat(const Cat&) -> std::string {
+    return "hiss";
+}
+
+BOOST_OPENMETHOD_REGISTER(poke::override<poke_dog, poke_cat>);
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), std::string) {
+    return "chase";
+}
+
+using counters = test_registry::instrumentation;
+
+BOOST_AUTO_TEST_CASE(count_calls) {
+    test_registry::initialize();
+    counters::reset();
+
+    Dog dog;
+    Cat cat;
+
+    for (int i = 0; i < 3; ++i) {
+        poke::fn(dog);
+    }
+
+    poke::fn(cat);
+    meet(dog, cat);
+
+    std::thread([&] {
+        poke::fn(cat);
+        meet(dog, cat);
+    }).join();
+
+    auto counts = counters::snapshot();
+    using rtti = test_registry::rtti;
+    auto& pokes = counts.methods[rtti::static_type<poke>()];
+    BOOST_TEST(pokes.calls == 5u);
+    BOOST_TEST(pokes.overriders.size() == 2u);
+
+    for (auto& [pf, calls] : pokes.overriders) {
+        BOOST_TEST((calls == 3u || calls == 2u));
+    }
+
+    BOOST_TEST(counts.methods.size() == 2u);
+    std::ostringstream poke_name;
+    rtti::type_name(rtti::static_type<poke>(), poke_name);
+    BOOST_TEST(counts.method_hits<test_registry>()[poke_name.str()] == 5u);
+
+    // Merging adds the counts.
+    counts.merge(counters::snapshot());
+    BOOST_TEST(pokes.calls == 10u);
+
+    counters::reset();
+    BOOST_TEST(counters::snapshot().methods[pokes.method->method_type_id]
+                   .calls == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(write_counts) {
+    test_registry::initialize();
+    counters::reset();
+
+    Dog dog;
+    Cat cat;
+    meet(dog, cat);
+    BOOST_CHECK_THROW(meet(cat, dog), not_implemented_error);
+
+    std::ostringstream text, json;
+    auto counts = counters::snapshot();
+    counts.write<test_registry>(text);
+    counts.write_json<test_registry>(json);
+
+    BOOST_TEST(text.str().find(": 2\n") != std::string::npos);
+    BOOST_TEST(text.str().find("  not implemented: 1\n") != std::string::npos);
+    BOOST_TEST(json.str().front() == '[');
+    BOOST_TEST(json.str().back() == ']');
+    BOOST_TEST(
+        json.str().find(R"({"overrider": "not implemented", "calls": 1})") !=
+        std::string::npos);
+}
+
+template<class Registry, class Meet>
+void check_trampolines() {
+    using counters = typename Registry::instrumentation;
+    Registry::initialize();
+    counters::reset();
+
+    Dog dog;
+    Cat cat;
+
+    for (int i = 0; i < 3; ++i) {
+        BOOST_TEST(Meet::fn(dog, cat) == "chase");
+    }
+
+    auto counts = counters::snapshot();
+    auto& meets = counts.methods[Registry::rtti::template static_type<Meet>()];
+    BOOST_TEST(meets.calls == 3u);
+    BOOST_TEST(meets.overriders.size() == 1u);
+
+    for (auto& [pf, calls] : meets.overriders) {
+        BOOST_TEST(pf == Meet::fn.specs.begin()->pf);
+        BOOST_TEST(calls == 3u);
+    }
+}
+
+auto meet_dog_cat(const Dog&, const Cat&) -> std::string {
+    return "chase";
+}
+
+namespace lazy {
+
+struct test_registry
+    : test_registry_<
+          __COUNTER__, policies::call_counters, policies::lazy_dispatch> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(meet);
+using meet = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(meet::override<meet_dog_cat>);
+
+BOOST_AUTO_TEST_CASE(count_lazy_calls) {
+    check_trampolines<test_registry, meet>();
+}
+
+} // namespace lazy
+
+namespace interpreted {
+
+struct test_registry
+    : test_registry_<
+          __COUNTER__, policies::call_counters,
+          policies::interpreted_dispatch_options<1, 4>> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(meet);
+using meet = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(meet::override<meet_dog_cat>);
+
+BOOST_AUTO_TEST_CASE(count_interpreted_calls) {
+    check_trampolines<test_registry, meet>();
+}
+
+} // namespace interpreted
@@ -0,0 +1,103 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/throw_error_handler.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE compact_dispatch
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Bulldog : Dog {};
+struct Cat : Animal {};
+
+struct test_registry
+    : test_registry_<
+          __COUNTER__, policies::compact_dispatch,
+          policies::reorder_dimensions, policies::throw_error_handler> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+BOOST_OPENMETHOD_CLASSES(Dog, Bulldog, test_registry);
+
+BOOST_OPENMETHOD(
+    name, (virtual_<const Animal&>), std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Animal&), std::string) {
+    return "animal";
+}
+
+// 4 x 3 cells
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), std::string) {
+    return "chase";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Bulldog&, const Cat&), std::string) {
+    return "bulldog " + next(Bulldog(), Cat());
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Cat&, const Dog&), std::string) {
+    return "run";
+}
+
+// 2 x 2 x 2 cells
+
+BOOST_OPENMETHOD(
+    chorus,
+    (virtual_<const Animal&>, const std::string&, virtual_<const Animal&>,
+     virtual_<const Animal&>),
+    std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    chorus,
+    (const Animal&, const std::string& tune, const Animal&, const Animal&),
+    std::string) {
+    return tune;
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    chorus, (const Dog&, const std::string&, const Dog&, const Dog&),
+    std::string) {
+    return "howl";
+}
+
+BOOST_AUTO_TEST_CASE(compact_cells) {
+    auto report = test_registry::initialize().report;
+    BOOST_TEST(report.cells == 20u);
+    BOOST_TEST(report.bytes_saved == 20u * (sizeof(void*) - 4));
+
+    Animal animal;
+    Dog dog;
+    Bulldog bulldog;
+    Cat cat;
+
+    BOOST_TEST(name(bulldog) == "animal");
+
+    BOOST_TEST(meet(dog, cat) == "chase");
+    BOOST_TEST(meet(bulldog, cat) == "bulldog chase");
+    BOOST_TEST(meet(cat, bulldog) == "run");
+    BOOST_CHECK_THROW(meet(dog, dog), not_implemented_error);
+    BOOST_CHECK_THROW(meet(animal, cat), not_implemented_error);
+
+    BOOST_TEST(chorus(dog, "la", bulldog, dog) == "howl");
+    BOOST_TEST(chorus(dog, "la", cat, dog) == "la");
+    BOOST_TEST(chorus(animal, "la", animal, animal) == "la");
+}
@@ -0,0 +1,358 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <atomic>
+#include <optional>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE deferred_reclamation
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::deferred_reclamation> {
+};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+BOOST_OPENMETHOD(
+    name, (virtual_ptr<const Animal, test_registry>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    name, (virtual_ptr<const Animal, test_registry>), std::string) {
+    return "animal";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    name, (virtual_ptr<const Dog, test_registry>), std::string) {
+    return "dog";
+}
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    meet, (const Animal&, const Animal&), std::string) {
+    return "ignore";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), std::string) {
+    return "chase";
+}
+
+BOOST_AUTO_TEST_CASE(previous_generation_remains_valid) {
+    test_registry::initialize();
+
+    Dog snoopy;
+    virtual_ptr<const Animal, test_registry> p(snoopy);
+    auto old_vptr = p.vptr();
+    BOOST_TEST(name(p) == "dog");
+
+    // Add a class, so the tables are rebuilt in a different place.
+    struct Bulldog : Dog {};
+    BOOST_OPENMETHOD_REGISTER(use_classes<Dog, Bulldog, test_registry>);
+
+    test_registry::initialize();
+
+    BOOST_TEST(test_registry::static_vptr<Dog> != old_vptr);
+
+    // The previous generation is still alive.
+    BOOST_TEST(old_vptr[0].pf != nullptr);
+
+    // `p` acquires the v-table pointer of the current generation again.
+    BOOST_TEST(p.vptr() == test_registry::static_vptr<Dog>);
+    BOOST_TEST(name(p) == "dog");
+
+    test_registry::reclaim();
+
+    BOOST_TEST(
+        name(virtual_ptr<const Animal, test_registry>(snoopy)) == "dog");
+}
+
+BOOST_AUTO_TEST_CASE(calls_during_initialize) {
+    test_registry::initialize();
+
+    constexpr int readers = 4;
+    std::atomic<bool> stop{false};
+    std::atomic<int> started{0};
+    std::vector<std::atomic<long>> calls(readers), errors(readers);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < readers; ++i) {
+        threads.emplace_back([&, i] {
+            Dog dog;
+            Cat cat;
+            ++started;
+
+            while (!stop.load()) {
+                if (meet(dog, cat) != "chase" || meet(cat, dog) != "ignore" ||
+                    name(virtual_ptr<const Animal, test_registry>(cat)) !=
+                        "animal" ||
+                    name(final_virtual_ptr<test_registry>(dog)) != "dog") {
+                    ++errors[i];
+                }
+
+                ++calls[i];
+            }
+        });
+    }
+
+    while (started.load() != readers) {
+        std::this_thread::yield();
+    }
+
+    // Publish new generations while the readers are dispatching.
+    for (int i = 0; i < 50; ++i) {
+        test_registry::initialize();
+    }
+
+    stop = true;
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < readers; ++i) {
+        BOOST_TEST(calls[i].load() > 0);
+        BOOST_TEST(errors[i].load() == 0);
+    }
+
+    test_registry::reclaim();
+}
+
+namespace test_moving_slots {
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+struct Robot {
+    virtual ~Robot() {
+    }
+};
+
+struct Android : Robot {};
+
+// Joins the two hierarchies, thus the methods of Animal and Robot cannot share
+// slots any more.
+struct Cyborg : Dog, Robot {};
+
+struct Circle {};
+struct Square {};
+
+using Shape = std::variant<Circle, Square>;
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::deferred_reclamation> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+BOOST_OPENMETHOD_CLASSES(Robot, Android, test_registry);
+BOOST_OPENMETHOD_CLASSES(Shape, Circle, Square, test_registry);
+
+BOOST_OPENMETHOD(
+    name, (virtual_ptr<const Animal, test_registry>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    name, (virtual_ptr<const Animal, test_registry>), std::string) {
+    return "animal";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    name, (virtual_ptr<const Dog, test_registry>), std::string) {
+    return "dog";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    name, (virtual_ptr<const Cat, test_registry>), std::string) {
+    return "cat";
+}
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    meet, (const Animal&, const Animal&), std::string) {
+    return "ignore";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), std::string) {
+    return "chase";
+}
+
+BOOST_OPENMETHOD(beep, (virtual_<const Robot&>), std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(beep, (const Robot&), std::string) {
+    return "robot";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(beep, (const Android&), std::string) {
+    return "android";
+}
+
+BOOST_OPENMETHOD(area, (virtual_<const Shape&>), std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(area, (const Circle&), std::string) {
+    return "circle";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(area, (const Square&), std::string) {
+    return "square";
+}
+
+BOOST_AUTO_TEST_CASE(calls_while_slots_move) {
+    test_registry::initialize();
+
+    constexpr int readers = 4;
+    std::atomic<bool> stop{false};
+    std::atomic<int> started{0};
+    std::vector<std::atomic<long>> calls(readers), errors(readers);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < readers; ++i) {
+        threads.emplace_back([&, i] {
+            Dog dog;
+            Cat cat;
+            Android android;
+            Shape square = Square();
+
+            // Kept across the re-initializations.
+            virtual_ptr<const Animal, test_registry> held(dog);
+
+            ++started;
+
+            while (!stop.load()) {
+                if (name(held) != "dog" ||
+                    name(final_virtual_ptr<test_registry>(cat)) != "cat" ||
+                    meet(dog, cat) != "chase" || meet(cat, dog) != "ignore" ||
+                    beep(android) != "android" || area(square) != "square") {
+                    ++errors[i];
+                }
+
+                ++calls[i];
+            }
+        });
+    }
+
+    while (started.load() != readers) {
+        std::this_thread::yield();
+    }
+
+    // Register and unregister classes, so the slots of the methods, and the
+    // layout of the v-tables, change with each generation.
+    std::optional<use_classes<Dog, Robot, Cyborg, test_registry>> cyborg;
+
+    for (int i = 0; i < 50; ++i) {
+        if (cyborg) {
+            cyborg.reset();
+        } else {
+            cyborg.emplace();
+        }
+
+        test_registry::initialize();
+    }
+
+    stop = true;
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < readers; ++i) {
+        BOOST_TEST(calls[i].load() > 0);
+        BOOST_TEST(errors[i].load() == 0);
+    }
+
+    test_registry::reclaim();
+}
+
+} // namespace test_moving_slots
+
+namespace test_next_during_initialize {
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::deferred_reclamation> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(describe);
+
+using describe = method<
+    BOOST_OPENMETHOD_ID(describe), auto(virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+auto describe_animal(const Animal&) -> std::string {
+    return "animal";
+}
+
+auto describe_dog(const Dog& dog) -> std::string {
+    return "dog " + describe::next<describe_dog>(dog);
+}
+
+BOOST_OPENMETHOD_REGISTER(describe::override<describe_animal, describe_dog>);
+
+BOOST_AUTO_TEST_CASE(next_during_initialize) {
+    test_registry::initialize();
+    auto next = describe::next<describe_dog>.load();
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> errors{0};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&] {
+            Dog dog;
+
+            do {
+                if (describe::fn(dog) != "dog animal") {
+                    ++errors;
+                }
+            } while (!stop.load());
+        });
+    }
+
+    for (int i = 0; i < 20; ++i) {
+        test_registry::initialize();
+    }
+
+    stop = true;
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    BOOST_TEST(errors.load() == 0);
+
+    // The pointer did not change, thus it was not rewritten.
+    BOOST_TEST(describe::next<describe_dog>.load() == next);
+
+    test_registry::reclaim();
+}
+
+} // namespace test_next_during_initialize
@@ -447,3 +447,93 @@ BOOST_AUTO_TEST_CASE(comma_in_return_type) {
 }
 
 } // namespace test_comma_in_return_type
+
+namespace test_shared_vtables {
+
+using test_registry = test_registry_<__COUNTER__>;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Bulldog : Dog {};
+struct Husky : Dog {};
+struct Cat : Animal {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Bulldog, Husky, Cat, test_registry);
+
+BOOST_OPENMETHOD(poke, (virtual_<Animal&>), std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(poke, (Animal&), std::string) {
+    return "growl";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(poke, (Dog&), std::string) {
+    return "bark";
+}
+
+BOOST_AUTO_TEST_CASE(shared_vtables) {
+    auto report = test_registry::initialize().report;
+    BOOST_TEST(report.unique_vtables == 2u);
+    BOOST_TEST(
+        test_registry::static_vptr<Bulldog> ==
+        test_registry::static_vptr<Dog>);
+    BOOST_TEST(
+        test_registry::static_vptr<Cat> == test_registry::static_vptr<Animal>);
+    BOOST_TEST(
+        test_registry::static_vptr<Cat> != test_registry::static_vptr<Dog>);
+
+    Husky husky;
+    Cat cat;
+    BOOST_TEST(poke(husky) == "bark");
+    BOOST_TEST(poke(cat) == "growl");
+}
+
+} // namespace test_shared_vtables
+
+namespace test_non_virtual_between_virtuals {
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat);
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, int, virtual_<const Animal&>),
+    std::string);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    meet, (const Animal&, int, const Animal&), std::string) {
+    return "ignore";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    meet, (const Dog&, int times, const Cat&), std::string) {
+    return "chase " + std::to_string(times);
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Cat&, int, const Dog&), std::string) {
+    return "run";
+}
+
+BOOST_AUTO_TEST_CASE(non_virtual_between_virtuals) {
+    initialize();
+
+    Dog dog;
+    Cat cat;
+
+    // The last virtual argument must not be skipped.
+    BOOST_TEST(meet(dog, 2, cat) == "chase 2");
+    BOOST_TEST(meet(cat, 2, dog) == "run");
+    BOOST_TEST(meet(dog, 2, dog) == "ignore");
+    BOOST_TEST(meet(cat, 2, cat) == "ignore");
+}
+
+} // namespace test_non_virtual_between_virtuals
@@ -0,0 +1,169 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE drop_abstract_groups
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+
+    virtual void breathe() = 0;
+};
+
+struct Pet : Animal {
+    virtual void play() = 0;
+};
+
+struct Feline : Pet {
+    virtual void purr() = 0;
+};
+
+struct Dog : Pet {
+    void breathe() override {
+    }
+
+    void play() override {
+    }
+};
+
+struct Cat : Feline {
+    void breathe() override {
+    }
+
+    void play() override {
+    }
+
+    void purr() override {
+    }
+};
+
+struct Fish : Animal {
+    void breathe() override {
+    }
+};
+
+// Groups for the first virtual parameter: {Animal}, {Pet}, {Feline, Cat},
+// {Dog}. For the second: {Animal}, {Pet, Feline, Dog}, {Cat}.
+
+auto meet_animals(Animal&, Animal&) -> std::string {
+    return "ignore";
+}
+
+auto meet_pets(Pet&, Pet&) -> std::string {
+    return "play";
+}
+
+auto meet_feline_pet(Feline&, Pet&) -> std::string {
+    return "hiss";
+}
+
+auto meet_dog_cat(Dog&, Cat&) -> std::string {
+    return "chase";
+}
+
+namespace all_groups {
+
+struct test_registry : test_registry_<__COUNTER__> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Pet, Feline, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(meet);
+using meet = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<Animal&>, virtual_<Animal&>)->std::string, test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(
+    meet::override<meet_animals, meet_pets, meet_feline_pet, meet_dog_cat>);
+
+BOOST_AUTO_TEST_CASE(abstract_groups_kept) {
+    auto report = test_registry::initialize().report;
+    BOOST_TEST(report.cells == 12u);
+    BOOST_TEST(report.abstract_groups == 0u);
+}
+
+} // namespace all_groups
+
+namespace root_overrider {
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::drop_abstract_groups> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Pet, Feline, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(meet);
+using meet = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<Animal&>, virtual_<Animal&>)->std::string, test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(
+    meet::override<meet_animals, meet_pets, meet_feline_pet, meet_dog_cat>);
+
+BOOST_AUTO_TEST_CASE(abstract_groups_merged) {
+    auto report = test_registry::initialize().report;
+
+    // meet_animals applies to all the classes, thus there is no empty group.
+    // {Animal} and {Pet} are merged in a new one for the first parameter.
+    // {Animal} is kept for the second: merging it would not save a row.
+    BOOST_TEST(report.abstract_groups == 1u);
+    BOOST_TEST(report.cells == 9u);
+    BOOST_TEST(report.not_implemented == 0u);
+    BOOST_TEST(report.ambiguous == 0u);
+
+    Dog dog;
+    Cat cat;
+
+    BOOST_TEST(meet::fn(dog, cat) == "chase");
+    BOOST_TEST(meet::fn(cat, dog) == "hiss");
+    BOOST_TEST(meet::fn(cat, cat) == "hiss");
+    BOOST_TEST(meet::fn(dog, dog) == "play");
+}
+
+} // namespace root_overrider
+
+namespace empty_group {
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::drop_abstract_groups> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Pet, Feline, Dog, Cat, Fish, test_registry);
+
+struct BOOST_OPENMETHOD_ID(meet);
+using meet = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<Animal&>, virtual_<Animal&>)->std::string, test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(
+    meet::override<meet_pets, meet_feline_pet, meet_dog_cat>);
+
+BOOST_AUTO_TEST_CASE(abstract_groups_dropped) {
+    auto report = test_registry::initialize().report;
+
+    // Groups for the first parameter: {Animal, Fish} (empty), {Pet},
+    // {Feline, Cat}, {Dog}; {Pet} is merged in the empty group. For the
+    // second: {Animal, Fish} (empty), {Pet, Feline, Dog}, {Cat}.
+    BOOST_TEST(report.cells == 9u);
+    BOOST_TEST(report.abstract_groups == 1u);
+    BOOST_TEST(report.ambiguous == 0u);
+
+    Dog dog;
+    Cat cat;
+
+    BOOST_TEST(meet::fn(dog, cat) == "chase");
+    BOOST_TEST(meet::fn(cat, dog) == "hiss");
+    BOOST_TEST(meet::fn(cat, cat) == "hiss");
+    BOOST_TEST(meet::fn(dog, dog) == "play");
+}
+
+} // namespace empty_group
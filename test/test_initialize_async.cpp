@@ -0,0 +1,235 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/shared_ptr.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE initialize_async
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Bulldog : Dog {};
+struct Cat : Animal {};
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::fallback_dispatch> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+BOOST_OPENMETHOD_CLASSES(Dog, Bulldog, test_registry);
+
+BOOST_OPENMETHOD(
+    name, (virtual_<const Animal&>), std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Animal&), std::string) {
+    return "animal";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Dog& dog), std::string) {
+    return "dog " + next(dog);
+}
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Bulldog& dog), std::string) {
+    return "bulldog " + next(dog);
+}
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    meet, (const Animal&, const Animal&), std::string) {
+    return "ignore";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), std::string) {
+    return "chase";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Cat&, const Dog&), std::string) {
+    return "run";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Animal&), std::string) {
+    return "sniff";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Animal&, const Dog&), std::string) {
+    return "sniff back";
+}
+
+BOOST_OPENMETHOD(
+    sound, (virtual_ptr<const Animal, test_registry>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    sound, (virtual_ptr<const Animal, test_registry>), std::string) {
+    return "...";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    sound, (virtual_ptr<const Dog, test_registry>), std::string) {
+    return "woof";
+}
+
+auto check_calls() {
+    Animal animal;
+    Dog dog;
+    Bulldog bulldog;
+    Cat cat;
+
+    BOOST_TEST(name(animal) == "animal");
+    BOOST_TEST(name(dog) == "dog animal");
+    BOOST_TEST(name(bulldog) == "bulldog dog animal");
+    BOOST_TEST(name(cat) == "animal");
+
+    BOOST_TEST(meet(animal, cat) == "ignore");
+    BOOST_TEST(meet(bulldog, cat) == "chase");
+    BOOST_TEST(meet(cat, bulldog) == "run");
+    BOOST_TEST(meet(dog, animal) == "sniff");
+    BOOST_TEST(meet(cat, dog) == "run");
+}
+
+BOOST_AUTO_TEST_CASE(has_next_before_initialize) {
+    // Until the dispatch data is published, `next` holds the fallback, which
+    // is not an overrider: `has_next` resolves the next overrider instead.
+    BOOST_TEST(!test_registry::is_initialized());
+
+    BOOST_TEST(!BOOST_OPENMETHOD_OVERRIDER(
+        name, (const Animal&), std::string)::has_next());
+    BOOST_TEST(BOOST_OPENMETHOD_OVERRIDER(
+        name, (const Dog& dog), std::string)::has_next());
+    BOOST_TEST(BOOST_OPENMETHOD_OVERRIDER(
+        name, (const Bulldog& dog), std::string)::has_next());
+    BOOST_TEST(!BOOST_OPENMETHOD_OVERRIDER(
+        meet, (const Animal&, const Animal&), std::string)::has_next());
+    BOOST_TEST(BOOST_OPENMETHOD_OVERRIDER(
+        meet, (const Dog&, const Cat&), std::string)::has_next());
+}
+
+BOOST_AUTO_TEST_CASE(fallback_then_tables) {
+    BOOST_TEST(!test_registry::is_initialized());
+
+    // Calls are legal, and resolved without the dispatch tables.
+    check_calls();
+
+    // virtual_ptrs made before the publication remain usable after it.
+    Dog dog;
+    auto shared_dog = std::make_shared<const Dog>();
+    virtual_ptr<const Animal, test_registry> early(dog);
+    virtual_ptr<std::shared_ptr<const Animal>, test_registry> early_shared(
+        shared_dog);
+    BOOST_TEST(sound(early) == "woof");
+
+    auto done = test_registry::initialize_async();
+    check_calls();
+    done.get();
+
+    BOOST_TEST(test_registry::is_initialized());
+    check_calls();
+
+    BOOST_TEST(early.vptr() == test_registry::static_vptr<Dog>);
+    BOOST_TEST(early_shared.vptr() == test_registry::static_vptr<Dog>);
+    BOOST_TEST(sound(early) == "woof");
+}
+
+BOOST_AUTO_TEST_CASE(ancestors_cleared) {
+    // The classes may change between initializations, thus the ancestors
+    // memoized by the fallback path are discarded when the epoch changes.
+    auto& memo = detail::fallback_resolver<test_registry>::memo();
+
+    test_registry::finalize();
+    check_calls();
+    BOOST_TEST(memo.epoch == test_registry::epoch);
+    auto entries = memo.entries.size();
+
+    test_registry::finalize();
+    Dog dog;
+    BOOST_TEST(sound(dog) == "woof");
+    BOOST_TEST(memo.epoch == test_registry::epoch);
+    BOOST_TEST(memo.entries.size() < entries);
+
+    test_registry::initialize();
+    check_calls();
+}
+
+namespace class_template_overriders {
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::fallback_dispatch> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+BOOST_OPENMETHOD_CLASSES(Dog, Bulldog, test_registry);
+
+struct BOOST_OPENMETHOD_ID(describe);
+
+using describe = method<
+    BOOST_OPENMETHOD_ID(describe), auto(virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+auto describe_animal(const Animal&) -> std::string {
+    return "animal";
+}
+
+auto describe_dog(const Dog& dog) -> std::string {
+    return "dog " + describe::next<describe_dog>(dog);
+}
+
+auto describe_bulldog(const Bulldog& dog) -> std::string {
+    return "bulldog " + describe::next<describe_bulldog>(dog);
+}
+
+BOOST_OPENMETHOD_REGISTER(
+    describe::override<describe_animal, describe_dog, describe_bulldog>);
+
+BOOST_AUTO_TEST_CASE(next_during_initialize_async) {
+    // `next<Fn>` is read atomically, thus class template overriders can call
+    // it while the dispatch data is being published.
+    std::atomic<bool> stop{false};
+    std::atomic<int> errors{0};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&] {
+            Dog dog;
+            Bulldog bulldog;
+
+            do {
+                if (describe::fn(dog) != "dog animal" ||
+                    describe::fn(bulldog) != "bulldog dog animal") {
+                    ++errors;
+                }
+            } while (!stop.load());
+        });
+    }
+
+    test_registry::initialize_async().get();
+    BOOST_TEST(test_registry::is_initialized());
+
+    stop = true;
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    BOOST_TEST(errors.load() == 0);
+}
+
+} // namespace class_template_overriders
@@ -0,0 +1,116 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/throw_error_handler.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE inline_rows
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Bulldog : Dog {};
+struct Cat : Animal {};
+
+struct test_registry
+    : test_registry_<
+          __COUNTER__, policies::inline_rows_options<2>,
+          policies::throw_error_handler> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+BOOST_OPENMETHOD_CLASSES(Dog, Bulldog, test_registry);
+
+BOOST_OPENMETHOD(
+    name, (virtual_<const Animal&>), std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Animal&), std::string) {
+    return "animal";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Dog&), std::string) {
+    return "dog";
+}
+
+// 3 x 2 cells, the rows are stored in the v-tables.
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Animal&, const Animal&), std::string) {
+    return "ignore";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), std::string) {
+    return "chase";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Bulldog&, const Cat&), std::string) {
+    return "bulldog " + next(Bulldog(), Cat());
+}
+
+// 2 x 3 cells, the rows are too long.
+
+BOOST_OPENMETHOD(
+    fight, (virtual_<const Animal&>, virtual_<const Animal&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    fight, (const Animal&, const Animal&), std::string) {
+    return "ignore";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(fight, (const Cat&, const Dog&), std::string) {
+    return "scratch";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(fight, (const Cat&, const Bulldog&), std::string) {
+    return "flee";
+}
+
+using meet_method = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+using fight_method = method<
+    BOOST_OPENMETHOD_ID(fight),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+BOOST_AUTO_TEST_CASE(rows_in_vtables) {
+    auto report = test_registry::initialize().report;
+    BOOST_TEST(report.inline_rows == 1u);
+    BOOST_TEST(meet_method::fn.inline_row);
+    BOOST_TEST(!fight_method::fn.inline_row);
+
+    Animal animal;
+    Dog dog;
+    Bulldog bulldog;
+    Cat cat;
+
+    BOOST_TEST(name(bulldog) == "dog");
+    BOOST_TEST(name(cat) == "animal");
+
+    BOOST_TEST(meet(dog, cat) == "chase");
+    BOOST_TEST(meet(bulldog, cat) == "bulldog chase");
+    BOOST_TEST(meet(cat, dog) == "ignore");
+    BOOST_TEST(meet(bulldog, dog) == "ignore");
+    BOOST_TEST(meet(animal, cat) == "ignore");
+
+    BOOST_TEST(fight(cat, dog) == "scratch");
+    BOOST_TEST(fight(cat, bulldog) == "flee");
+    BOOST_TEST(fight(dog, cat) == "ignore");
+}
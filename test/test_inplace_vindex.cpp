@@ -0,0 +1,183 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <iostream>
+#include <string>
+
+#include <boost/openmethod/default_registry.hpp>
+
+namespace bom = boost::openmethod;
+struct test_registry : bom::default_registry::without<
+                           bom::policies::vptr, bom::policies::type_hash> {};
+
+#define BOOST_OPENMETHOD_DEFAULT_REGISTRY test_registry
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/inplace_vindex.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#define BOOST_TEST_MODULE inplace_vindex
+#include <boost/test/unit_test.hpp>
+
+using bom::virtual_;
+
+struct Animal : bom::inplace_vindex<Animal> {
+    explicit Animal(std::ostream& os);
+    ~Animal();
+    std::ostream& os;
+};
+
+struct Cat : Animal, bom::inplace_vindex<Cat, Animal> {
+    explicit Cat(std::ostream& os);
+    ~Cat();
+};
+
+struct Pet : bom::inplace_vindex<Pet> {
+    explicit Pet(std::ostream& os);
+    ~Pet();
+    std::string name;
+    std::ostream& os;
+};
+
+struct DomesticCat : Cat, Pet, bom::inplace_vindex<DomesticCat, Cat, Pet> {
+    explicit DomesticCat(std::ostream& os);
+    ~DomesticCat();
+};
+
+BOOST_OPENMETHOD(
+    speak, (virtual_<const Animal&> animal, std::ostream& os), void);
+
+BOOST_OPENMETHOD(describe, (virtual_<const Pet&> pet, std::ostream& os), void);
+
+Animal::Animal(std::ostream& os) : os(os) {
+    speak(*this, os);
+}
+
+Animal::~Animal() {
+    speak(*this, os);
+}
+
+Cat::Cat(std::ostream& os) : Animal(os) {
+    speak(*this, os);
+}
+
+Cat::~Cat() {
+    speak(*this, os);
+}
+
+Pet::Pet(std::ostream& os) : os(os) {
+    describe(*this, os);
+}
+
+Pet::~Pet() {
+    describe(*this, os);
+}
+
+DomesticCat::DomesticCat(std::ostream& os) : Cat(os), Pet(os) {
+    name = "Felix";
+    describe(*this, os);
+}
+
+DomesticCat::~DomesticCat() {
+    describe(*this, Cat::os);
+}
+
+BOOST_OPENMETHOD_OVERRIDE(speak, (const Animal&, std::ostream& os), void) {
+    os << "???\n";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(speak, (const Cat&, std::ostream& os), void) {
+    os << "meow\n";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(describe, (const Pet&, std::ostream& os), void) {
+    os << "I am a pet\n";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    describe, (const DomesticCat& pet, std::ostream& os), void) {
+    os << "I am " << pet.name << " the cat\n";
+}
+
+BOOST_AUTO_TEST_CASE(inplace_vindex_mode) {
+    bom::initialize();
+
+    std::ostringstream cd_output;
+    auto cat = std::make_unique<DomesticCat>(cd_output);
+
+    BOOST_TEST(
+        cd_output.str() ==
+        "???\n"
+        "meow\n"
+        "I am a pet\n"
+        "I am Felix the cat\n");
+
+    {
+        std::ostringstream output;
+        describe(*cat, output);
+        BOOST_TEST(output.str() == "I am Felix the cat\n");
+    }
+
+    {
+        std::ostringstream output;
+        speak(*cat, output);
+        BOOST_TEST(output.str() == "meow\n");
+    }
+
+    cd_output.str("");
+    cat.reset();
+
+    BOOST_TEST(
+        cd_output.str() ==
+        "I am Felix the cat\n"
+        "I am a pet\n"
+        "meow\n"
+        "???\n");
+}
+
+struct Node : bom::inplace_vindex<Node> {
+    int value;
+};
+
+struct Leaf : Node, bom::inplace_vindex<Leaf, Node> {};
+
+BOOST_OPENMETHOD(get_value, (virtual_<const Node&>), int);
+
+BOOST_OPENMETHOD_OVERRIDE(get_value, (const Node& node), int) {
+    return node.value;
+}
+
+BOOST_OPENMETHOD_OVERRIDE(get_value, (const Leaf& node), int) {
+    return -node.value;
+}
+
+BOOST_AUTO_TEST_CASE(inplace_vindex_reinitialize) {
+    static_assert(sizeof(Node) == 2 * sizeof(bom::vindex_type));
+
+    bom::initialize();
+
+    auto node_index = test_registry::static_vindex<Node>;
+    auto leaf_index = test_registry::static_vindex<Leaf>;
+    BOOST_TEST(node_index != 0u);
+    BOOST_TEST(leaf_index != 0u);
+    BOOST_TEST(node_index != leaf_index);
+
+    Leaf leaf;
+    leaf.value = 42;
+    BOOST_TEST(
+        boost_openmethod_vptr(leaf, (test_registry*)nullptr) ==
+        test_registry::static_vptr<Leaf>);
+    BOOST_TEST(get_value(leaf) == -42);
+
+    bom::finalize();
+    bom::initialize();
+
+    BOOST_TEST(test_registry::static_vindex<Node> == node_index);
+    BOOST_TEST(test_registry::static_vindex<Leaf> == leaf_index);
+    BOOST_TEST(
+        boost_openmethod_vptr(leaf, (test_registry*)nullptr) ==
+        test_registry::static_vptr<Leaf>);
+    BOOST_TEST(get_value(leaf) == -42);
+}
@@ -0,0 +1,225 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/throw_error_handler.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE interpreted_dispatch
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Bulldog : Dog {};
+struct Cat : Animal {};
+
+struct test_registry
+    : test_registry_<
+          __COUNTER__, policies::throw_error_handler,
+          policies::interpreted_dispatch_options<10, 4>> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+BOOST_OPENMETHOD_CLASSES(Dog, Bulldog, test_registry);
+
+// 3 x 4 cells, interpreted because of the threshold.
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), std::string) {
+    return "chase";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Bulldog&, const Cat&), std::string) {
+    return "bulldog " + next(Bulldog(), Cat());
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Cat&, const Dog&), std::string) {
+    return "run";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Animal&), std::string) {
+    return "sniff";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Animal&, const Dog&), std::string) {
+    return "sniff back";
+}
+
+// 2 x 2 cells, interpreted on request.
+
+BOOST_OPENMETHOD(
+    fight, (virtual_<const Animal&>, virtual_<const Animal&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(fight, (const Dog&, const Dog&), std::string) {
+    return "bark";
+}
+
+using fight_method = method<
+    BOOST_OPENMETHOD_ID(fight),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+template<>
+struct boost::openmethod::interpreted_method<fight_method> : std::true_type {
+};
+
+// 2 x 2 x 2 cells, uses a table.
+
+BOOST_OPENMETHOD(
+    chorus,
+    (virtual_<const Animal&>, virtual_<const Animal&>,
+     virtual_<const Animal&>),
+    std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    chorus, (const Animal&, const Animal&, const Animal&), std::string) {
+    return "noise";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    chorus, (const Dog&, const Dog&, const Dog&), std::string) {
+    return "howl";
+}
+
+using meet_method = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+using chorus_method = method<
+    BOOST_OPENMETHOD_ID(chorus),
+    auto(
+        virtual_<const Animal&>, virtual_<const Animal&>,
+        virtual_<const Animal&>)
+        ->std::string,
+    test_registry>;
+
+BOOST_AUTO_TEST_CASE(interpreted_methods) {
+    auto comp = test_registry::initialize();
+    BOOST_TEST(comp.report.interpreted == 2u);
+    BOOST_TEST(comp[meet_method::fn]->interpreted);
+    BOOST_TEST(comp[fight_method::fn]->interpreted);
+    BOOST_TEST(!comp[chorus_method::fn]->interpreted);
+
+    Animal animal;
+    Dog dog;
+    Bulldog bulldog;
+    Cat cat;
+
+    // Twice, to exercise the cache.
+    for (int i = 0; i < 2; ++i) {
+        BOOST_TEST(meet(dog, cat) == "chase");
+        BOOST_TEST(meet(bulldog, cat) == "bulldog chase");
+        BOOST_TEST(meet(cat, bulldog) == "run");
+        BOOST_TEST(meet(dog, animal) == "sniff");
+        BOOST_TEST(meet(animal, bulldog) == "sniff back");
+        BOOST_CHECK_THROW(meet(dog, dog), ambiguous_error);
+        BOOST_CHECK_THROW(meet(cat, cat), not_implemented_error);
+
+        BOOST_TEST(fight(bulldog, dog) == "bark");
+        BOOST_CHECK_THROW(fight(dog, cat), not_implemented_error);
+    }
+
+    BOOST_TEST(chorus(dog, bulldog, dog) == "howl");
+    BOOST_TEST(chorus(dog, cat, dog) == "noise");
+}
+
+BOOST_AUTO_TEST_CASE(interpreted_calls_in_threads) {
+    test_registry::initialize();
+
+    // Each thread fills its own cache.
+    std::atomic<int> errors{0};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&] {
+            Dog dog;
+            Bulldog bulldog;
+            Cat cat;
+
+            for (int j = 0; j < 1000; ++j) {
+                if (meet(dog, cat) != "chase" ||
+                    meet(bulldog, cat) != "bulldog chase" ||
+                    meet(cat, bulldog) != "run" ||
+                    fight(bulldog, dog) != "bark") {
+                    ++errors;
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    BOOST_TEST(errors.load() == 0);
+}
+
+struct Vehicle {
+    virtual ~Vehicle() {
+    }
+};
+
+struct Car : Vehicle {};
+struct Truck : Vehicle {};
+struct Bike : Vehicle {};
+
+struct large_registry
+    : test_registry_<
+          __COUNTER__, policies::interpreted_dispatch_options<20>> {};
+
+BOOST_OPENMETHOD_CLASSES(Vehicle, Car, Truck, Bike, large_registry);
+
+BOOST_OPENMETHOD(
+    convoy,
+    (virtual_<const Vehicle&>, virtual_<const Vehicle&>,
+     virtual_<const Vehicle&>, virtual_<const Vehicle&>),
+    std::string, large_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    convoy, (const Vehicle&, const Vehicle&, const Vehicle&, const Vehicle&),
+    std::string) {
+    return "mixed";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    convoy, (const Car&, const Car&, const Car&, const Car&), std::string) {
+    return "cars";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    convoy, (const Truck&, const Vehicle&, const Vehicle&, const Truck&),
+    std::string) {
+    return "escorted";
+}
+
+BOOST_AUTO_TEST_CASE(memory_saved) {
+    auto report = large_registry::initialize().report;
+    BOOST_TEST(report.interpreted == 1u);
+    BOOST_TEST(report.bytes_saved > 0u);
+
+    Car car;
+    Truck truck;
+    Bike bike;
+
+    BOOST_TEST(convoy(car, car, car, car) == "cars");
+    BOOST_TEST(convoy(truck, bike, car, truck) == "escorted");
+    BOOST_TEST(convoy(car, car, bike, car) == "mixed");
+}
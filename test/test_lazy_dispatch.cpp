@@ -0,0 +1,146 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE lazy_dispatch
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Bulldog : Dog {};
+struct Cat : Animal {};
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::lazy_dispatch> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+BOOST_OPENMETHOD_CLASSES(Dog, Bulldog, test_registry);
+
+BOOST_OPENMETHOD(
+    name, (virtual_<const Animal&>), std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Animal&), std::string) {
+    return "animal";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Dog& dog), std::string) {
+    return "dog " + next(dog);
+}
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Bulldog& dog), std::string) {
+    return "bulldog " + next(dog);
+}
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    meet, (const Animal&, const Animal&), std::string) {
+    return "ignore";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), std::string) {
+    return "chase";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Cat&, const Dog&), std::string) {
+    return "run";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Dog&), std::string) {
+    return "sniff";
+}
+
+using name_method = method<
+    BOOST_OPENMETHOD_ID(name), auto(virtual_<const Animal&>)->std::string,
+    test_registry>;
+using meet_method = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+auto entry(const detail::method_info& method, vptr_type vptr) {
+    return vptr[method.slots_strides_ptr[0]];
+}
+
+BOOST_AUTO_TEST_CASE(tables_built_on_first_call) {
+    auto comp = test_registry::initialize();
+    BOOST_TEST(comp.report.cells == 1u);
+
+    auto& name_info = name_method::fn;
+    auto& meet_info = meet_method::fn;
+    auto dog_vptr = test_registry::static_vptr<Dog>;
+
+    BOOST_TEST(entry(name_info, dog_vptr).pf == name_info.lazy_resolver);
+    BOOST_TEST(entry(meet_info, dog_vptr).pw->pf == meet_info.lazy_resolver);
+
+    Animal animal;
+    Dog dog;
+    Bulldog bulldog;
+    Cat cat;
+
+    BOOST_TEST(name(bulldog) == "bulldog dog animal");
+    BOOST_TEST(name(cat) == "animal");
+    BOOST_TEST(entry(name_info, dog_vptr).pf != name_info.lazy_resolver);
+
+    // Only `name` has been built.
+    BOOST_TEST(entry(meet_info, dog_vptr).pw->pf == meet_info.lazy_resolver);
+
+    BOOST_TEST(meet(bulldog, cat) == "chase");
+    BOOST_TEST(meet(cat, bulldog) == "run");
+    BOOST_TEST(meet(dog, bulldog) == "sniff");
+    BOOST_TEST(meet(animal, dog) == "ignore");
+    BOOST_TEST(entry(meet_info, dog_vptr).pw->pf != meet_info.lazy_resolver);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_first_calls) {
+    test_registry::initialize();
+
+    // Boost.Test assertions are not thread-safe: count the wrong results, and
+    // check the counts in the main thread.
+    std::atomic<int> calls{0}, errors{0};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&] {
+            Dog dog;
+            Cat cat;
+
+            for (int j = 0; j < 100; ++j) {
+                if (meet(dog, cat) != "chase" || meet(cat, dog) != "run" ||
+                    name(dog) != "dog animal") {
+                    ++errors;
+                }
+
+                ++calls;
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    BOOST_TEST(calls.load() == 400);
+    BOOST_TEST(errors.load() == 0);
+
+    test_registry::finalize();
+}
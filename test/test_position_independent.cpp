@@ -0,0 +1,117 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE position_independent
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::position_independent> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+BOOST_OPENMETHOD(
+    name, (virtual_<const Animal&>), std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Animal&), std::string) {
+    return "animal";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Dog&), std::string) {
+    return "dog";
+}
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Animal&, const Animal&), std::string) {
+    return "ignore";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), std::string) {
+    return "chase";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Cat&, const Dog&), std::string) {
+    return "run";
+}
+
+using shared = test_registry::policy<policies::position_independent>;
+
+auto in_image(const void* p) -> bool {
+    auto first = static_cast<const char*>(shared::image);
+    return p >= first && p < first + shared::image_size;
+}
+
+auto check_calls() {
+    Animal animal;
+    Dog dog;
+    Cat cat;
+
+    BOOST_TEST(name(dog) == "dog");
+    BOOST_TEST(name(cat) == "animal");
+    BOOST_TEST(meet(dog, cat) == "chase");
+    BOOST_TEST(meet(cat, dog) == "run");
+    BOOST_TEST(meet(animal, dog) == "ignore");
+}
+
+BOOST_AUTO_TEST_CASE(shared_image) {
+    test_registry::initialize();
+    BOOST_TEST(shared::image != nullptr);
+    BOOST_TEST(in_image(test_registry::static_vptr<Dog>));
+    check_calls();
+
+    // Simulate a shared mapping, filled by another process.
+    std::vector<detail::word> copy(shared::image_size / sizeof(detail::word));
+    std::memcpy(copy.data(), shared::image, shared::image_size);
+
+    shared::image = copy.data();
+    test_registry::initialize();
+    BOOST_TEST(shared::image == copy.data());
+    BOOST_TEST(in_image(test_registry::static_vptr<Dog>));
+    BOOST_TEST(in_image(test_registry::static_vptr<Cat>));
+    check_calls();
+
+    // An image with a different header is not used.
+    for (std::size_t i = 0; i < 2; ++i) {
+        shared::image = copy.data();
+        copy[i].i = ~copy[i].i;
+        test_registry::initialize();
+        BOOST_TEST(shared::image != copy.data());
+        check_calls();
+        copy[i].i = ~copy[i].i;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(reinitialize) {
+    test_registry::initialize();
+    auto first = shared::image;
+
+    // The image is the registry's own dispatch data, which is replaced.
+    test_registry::initialize();
+    BOOST_TEST(shared::image != first);
+    BOOST_TEST(in_image(test_registry::static_vptr<Dog>));
+    BOOST_TEST(in_image(test_registry::static_vptr<Cat>));
+    check_calls();
+}
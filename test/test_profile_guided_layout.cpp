@@ -0,0 +1,181 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE profile_guided_layout
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+struct Bird : Animal {};
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::profile_guided_layout> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, Bird, test_registry);
+
+BOOST_OPENMETHOD(
+    name, (virtual_<const Animal&>), std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Animal&), std::string) {
+    return "animal";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Dog&), std::string) {
+    return "dog";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Cat&), std::string) {
+    return "cat";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Bird&), std::string) {
+    return "bird";
+}
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Animal&, const Animal&), std::string) {
+    return "ignore";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), std::string) {
+    return "chase";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Bird&, const Bird&), std::string) {
+    return "sing";
+}
+
+BOOST_OPENMETHOD(
+    fight, (virtual_<const Animal&>, virtual_<const Animal&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    fight, (const Animal&, const Animal&), std::string) {
+    return "ignore";
+}
+
+using meet_method = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+using name_method = method<
+    BOOST_OPENMETHOD_ID(name), auto(virtual_<const Animal&>)->std::string,
+    test_registry>;
+using fight_method = method<
+    BOOST_OPENMETHOD_ID(fight),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+template<class Class>
+auto address(std::size_t slot) {
+    return &test_registry::static_vptr<Class>[slot];
+}
+
+auto key(type_id type) {
+    std::ostringstream os;
+    test_registry::rtti::type_name(type, os);
+
+    return os.str();
+}
+
+BOOST_AUTO_TEST_CASE(hot_first) {
+    // The profile is keyed by names, which do not change from one run to the
+    // next.
+    using profile = test_registry::policy<policies::profile_guided_layout>;
+    profile::class_hits["Bird"] = 1000;
+    profile::class_hits["Cat"] = 10;
+    profile::method_hits[key(fight_method::fn.method_type_id)] = 100;
+
+    test_registry::initialize();
+
+    // The v-table of the hottest class comes first.
+    auto slot = meet_method::fn.slots_strides_ptr[0];
+    BOOST_TEST(address<Bird>(slot) < address<Cat>(slot));
+    BOOST_TEST(address<Cat>(slot) < address<Dog>(slot));
+
+    // The group of the hottest class comes first.
+    auto second_slot = meet_method::fn.slots_strides_ptr[1];
+    BOOST_TEST(test_registry::static_vptr<Bird>[second_slot].i == 0u);
+
+    // The table of the hottest method comes first.
+    auto fight_slot = fight_method::fn.slots_strides_ptr[0];
+    BOOST_TEST(
+        test_registry::static_vptr<Animal>[fight_slot].pw <
+        test_registry::static_vptr<Animal>[slot].pw);
+
+    // A hot v-table that fits in a cache line does not straddle two, and the
+    // cold data does not share a line with the hot data.
+    std::size_t slots[] = {
+        name_method::fn.slots_strides_ptr[0], slot, second_slot, fight_slot,
+        fight_method::fn.slots_strides_ptr[1]};
+    auto [first_slot, last_slot] = std::minmax_element(
+        std::begin(slots), std::end(slots));
+    auto origin = reinterpret_cast<std::uintptr_t>(
+        test_registry::static_vptr<Animal>[fight_slot].pw);
+    auto line = [origin](const void* p) {
+        return (reinterpret_cast<std::uintptr_t>(p) - origin) /
+            policies::profile_guided_layout::cache_line_size;
+    };
+    BOOST_TEST(
+        line(address<Bird>(*first_slot)) == line(address<Bird>(*last_slot)));
+    BOOST_TEST(
+        line(address<Cat>(*first_slot)) == line(address<Cat>(*last_slot)));
+    BOOST_TEST(
+        line(address<Dog>(*first_slot)) > line(address<Cat>(*last_slot)));
+    BOOST_TEST(
+        line(address<Dog>(*first_slot)) > line(address<Bird>(*last_slot)));
+
+    Animal animal;
+    Dog dog;
+    Cat cat;
+    Bird bird;
+
+    BOOST_TEST(name(bird) == "bird");
+    BOOST_TEST(name(dog) == "dog");
+    BOOST_TEST(meet(dog, cat) == "chase");
+    BOOST_TEST(meet(bird, bird) == "sing");
+    BOOST_TEST(meet(cat, bird) == "ignore");
+    BOOST_TEST(meet(animal, dog) == "ignore");
+    BOOST_TEST(fight(bird, cat) == "ignore");
+}
+
+BOOST_AUTO_TEST_CASE(read_write) {
+    using profile = test_registry::policy<policies::profile_guided_layout>;
+    profile::class_hits["Dog"] = 5;
+    auto class_hits = profile::class_hits;
+    auto method_hits = profile::method_hits;
+
+    std::ostringstream os;
+    profile::write(os);
+    profile::class_hits.clear();
+    profile::method_hits.clear();
+
+    std::istringstream is(os.str());
+    BOOST_TEST(profile::read(is));
+    BOOST_TEST((profile::class_hits == class_hits));
+    BOOST_TEST((profile::method_hits == method_hits));
+
+    std::istringstream bad("vtable 3 Dog\n");
+    BOOST_TEST(!profile::read(bad));
+}
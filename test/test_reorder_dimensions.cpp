@@ -0,0 +1,87 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE reorder_dimensions
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+struct Bird : Animal {};
+
+struct Food {
+    virtual ~Food() {
+    }
+};
+
+struct Meat : Food {};
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::reorder_dimensions> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, Bird, Food, Meat, test_registry);
+
+// 2 groups for Food, 4 groups for Animal.
+BOOST_OPENMETHOD(
+    eat, (virtual_<const Food&>, virtual_<const Animal&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(eat, (const Food&, const Animal&), std::string) {
+    return "food";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(eat, (const Meat&, const Dog&), std::string) {
+    return "dog meat";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(eat, (const Meat&, const Cat&), std::string) {
+    return "cat meat";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(eat, (const Food&, const Bird&), std::string) {
+    return "bird food";
+}
+
+using eat_method = method<
+    BOOST_OPENMETHOD_ID(eat),
+    auto(virtual_<const Food&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+BOOST_AUTO_TEST_CASE(largest_dimension_first) {
+    auto comp = test_registry::initialize();
+    auto m = comp[eat_method::fn];
+    BOOST_TEST(m->first_stride == 4u);
+    BOOST_TEST(m->strides.size() == 1u);
+    BOOST_TEST(m->strides[0] == 1u);
+    BOOST_TEST(eat_method::fn.slots_strides_ptr[2] == 1u);
+
+    Food food;
+    Meat meat;
+    Animal animal;
+    Dog dog;
+    Cat cat;
+    Bird bird;
+
+    BOOST_TEST(eat(food, animal) == "food");
+    BOOST_TEST(eat(food, dog) == "food");
+    BOOST_TEST(eat(meat, animal) == "food");
+    BOOST_TEST(eat(meat, dog) == "dog meat");
+    BOOST_TEST(eat(meat, cat) == "cat meat");
+    BOOST_TEST(eat(food, bird) == "bird food");
+    BOOST_TEST(eat(meat, bird) == "bird food");
+}
@@ -0,0 +1,248 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE replace
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+struct test_registry : test_registry_<__COUNTER__> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(poke);
+using poke = method<
+    BOOST_OPENMETHOD_ID(poke), auto(virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+auto poke_animal(const Animal&) -> std::string {
+    return "animal";
+}
+
+auto poke_dog(const Dog&) -> std::string {
+    return "bark";
+}
+
+auto poke_dog_v2(const Dog& dog) -> std::string {
+    return "growl " + poke::next<poke_dog_v2>(dog);
+}
+
+BOOST_OPENMETHOD_REGISTER(poke::override<poke_animal, poke_dog>);
+
+struct BOOST_OPENMETHOD_ID(meet);
+using meet = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+auto meet_animals(const Animal&, const Animal&) -> std::string {
+    return "ignore";
+}
+
+auto meet_animals_v2(const Animal&, const Animal&) -> std::string {
+    return "sniff";
+}
+
+auto meet_dog_cat(const Dog& dog, const Cat& cat) -> std::string {
+    return "chase, then " + meet::next<meet_dog_cat>(dog, cat);
+}
+
+BOOST_OPENMETHOD_REGISTER(meet::override<meet_animals, meet_dog_cat>);
+
+BOOST_AUTO_TEST_CASE(replace_overriders) {
+    test_registry::initialize();
+
+    Animal animal;
+    Dog dog;
+    Cat cat;
+
+    BOOST_TEST(poke::fn(dog) == "bark");
+    BOOST_TEST(meet::fn(dog, cat) == "chase, then ignore");
+
+    // The vptrs do not change, and remain valid in the caches.
+    auto epoch = test_registry::epoch.load();
+    BOOST_TEST((poke::replace<poke_dog, poke_dog_v2>()));
+    BOOST_TEST(test_registry::epoch == epoch);
+    BOOST_TEST(poke::fn(dog) == "growl animal");
+    BOOST_TEST(poke::fn(cat) == "animal");
+
+    // In the dispatch table, and in the 'next' pointers.
+    BOOST_TEST((meet::replace<meet_animals, meet_animals_v2>()));
+    BOOST_TEST(meet::fn(cat, dog) == "sniff");
+    BOOST_TEST(meet::fn(animal, animal) == "sniff");
+    BOOST_TEST(meet::fn(dog, cat) == "chase, then sniff");
+
+    // Not an overrider (any more).
+    BOOST_TEST(!(meet::replace<meet_animals, meet_animals_v2>()));
+
+    // The replacements survive initialize.
+    test_registry::initialize();
+    BOOST_TEST(poke::fn(dog) == "growl animal");
+    BOOST_TEST(meet::fn(dog, cat) == "chase, then sniff");
+}
+
+namespace interpreted {
+
+struct test_registry
+    : test_registry_<
+          __COUNTER__, policies::interpreted_dispatch_options<1, 4>> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(meet);
+using meet = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+auto meet_dogs(const Dog&, const Dog&) -> std::string {
+    return "wag";
+}
+
+BOOST_OPENMETHOD_REGISTER(meet::override<meet_animals, meet_dogs>);
+
+BOOST_AUTO_TEST_CASE(replace_interpreted) {
+    test_registry::initialize();
+
+    Dog dog;
+    Cat cat;
+
+    // Fill the cache of interpreted dispatch.
+    BOOST_TEST(meet::fn(dog, dog) == "wag");
+    BOOST_TEST(meet::fn(dog, cat) == "ignore");
+    BOOST_TEST(meet::fn(dog, cat) == "ignore");
+
+    BOOST_TEST((meet::replace<meet_animals, meet_animals_v2>()));
+    BOOST_TEST(meet::fn(dog, cat) == "sniff");
+    BOOST_TEST(meet::fn(dog, dog) == "wag");
+}
+
+} // namespace interpreted
+
+namespace compact {
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::compact_dispatch> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(meet);
+using meet = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(meet::override<meet_animals>);
+
+BOOST_AUTO_TEST_CASE(replace_compact) {
+    test_registry::initialize();
+
+    Dog dog;
+    Cat cat;
+
+    BOOST_TEST(meet::fn(dog, cat) == "ignore");
+    BOOST_TEST((meet::replace<meet_animals, meet_animals_v2>()));
+    BOOST_TEST(meet::fn(dog, cat) == "sniff");
+    BOOST_TEST(meet::fn(cat, cat) == "sniff");
+}
+
+} // namespace compact
+
+namespace inline_rows {
+
+struct test_registry : test_registry_<__COUNTER__, policies::inline_rows> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(meet);
+using meet = method<
+    BOOST_OPENMETHOD_ID(meet),
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(meet::override<meet_animals>);
+
+BOOST_AUTO_TEST_CASE(replace_inline_rows) {
+    BOOST_TEST(test_registry::initialize().report.inline_rows == 1u);
+
+    Dog dog;
+    Cat cat;
+
+    // The cells are in the v-tables.
+    BOOST_TEST(meet::fn(dog, cat) == "ignore");
+    BOOST_TEST((meet::replace<meet_animals, meet_animals_v2>()));
+    BOOST_TEST(meet::fn(dog, cat) == "sniff");
+    BOOST_TEST(meet::fn(cat, dog) == "sniff");
+}
+
+} // namespace inline_rows
+
+namespace concurrent {
+
+struct test_registry : test_registry_<__COUNTER__> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(poke);
+using poke = method<
+    BOOST_OPENMETHOD_ID(poke), auto(virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+auto poke_dog_v2(const Dog&) -> std::string {
+    return "growl";
+}
+
+BOOST_OPENMETHOD_REGISTER(poke::override<poke_animal, poke_dog>);
+
+BOOST_AUTO_TEST_CASE(replace_while_calling) {
+    test_registry::initialize();
+
+    std::atomic<bool> started{false}, stop{false};
+    std::atomic<std::size_t> bad{0};
+
+    std::thread caller([&] {
+        Dog dog;
+
+        do {
+            auto result = poke::fn(dog);
+
+            if (result != "bark" && result != "growl") {
+                ++bad;
+            }
+
+            started = true;
+        } while (!stop);
+    });
+
+    while (!started) {
+    }
+
+    BOOST_TEST((poke::replace<poke_dog, poke_dog_v2>()));
+    stop = true;
+    caller.join();
+
+    Dog dog;
+    BOOST_TEST(bad == 0u);
+    BOOST_TEST(poke::fn(dog) == "growl");
+}
+
+} // namespace concurrent
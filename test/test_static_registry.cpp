@@ -0,0 +1,271 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+
+#include <boost/openmethod/static_registry.hpp>
+#include <boost/openmethod/inplace_vindex.hpp>
+#include <boost/openmethod/macros.hpp>
+#include <boost/openmethod/policies/throw_error_handler.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE static_registry
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Bulldog : Dog {};
+struct Cat : Animal {};
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::throw_error_handler> {};
+
+using animals = static_registry<Animal, Dog, Bulldog, Cat, test_registry>;
+
+auto poke_animal(const Animal&) -> std::string {
+    return "animal";
+}
+
+auto poke_dog(const Dog&) -> std::string;
+
+using poke = animals::method<
+    auto(virtual_<const Animal&>)->std::string, poke_animal, poke_dog>;
+
+auto poke_dog(const Dog& dog) -> std::string {
+    return "bark, then " + poke::next<poke_dog>(dog);
+}
+
+auto meet_animals(const Animal&, const std::string&, const Animal&)
+    -> std::string {
+    return "ignore";
+}
+
+auto meet_dog_cat(const Dog&, const std::string& where, const Cat&)
+    -> std::string {
+    return "chase in " + where;
+}
+
+auto meet_cat_dog(const Cat&, const std::string&, const Dog&) -> std::string {
+    return "run";
+}
+
+using meet = animals::method<
+    auto(
+        virtual_<const Animal&>, const std::string&, virtual_<const Animal&>)
+        ->std::string,
+    meet_animals, meet_dog_cat, meet_cat_dog>;
+
+auto pet_dog(Dog*) -> std::string {
+    return "wag";
+}
+
+using pet = animals::method<auto(virtual_<Dog*>)->std::string, pet_dog>;
+
+auto fight_dog_animal(const Dog&, const Animal&) -> std::string {
+    return "dog wins";
+}
+
+auto fight_animal_dog(const Animal&, const Dog&) -> std::string {
+    return "dog wins";
+}
+
+using fight = animals::method<
+    auto(virtual_<const Animal&>, virtual_<const Animal&>)->std::string,
+    fight_dog_animal, fight_animal_dog>;
+
+// The tables are computed during compilation.
+static_assert(poke::resolve<Bulldog>() == poke::resolve<Dog>());
+static_assert(poke::resolve<Cat>() == poke::resolve<Animal>());
+static_assert(poke::resolve<Dog>() != poke::resolve<Animal>());
+static_assert(poke::next<poke_dog> == poke::resolve<Animal>());
+static_assert(meet::resolve<Bulldog, Cat>() == meet::resolve<Dog, Cat>());
+static_assert(meet::resolve<Cat, Cat>() == meet::resolve<Animal, Dog>());
+static_assert(fight::resolve<Dog, Dog>() != fight::resolve<Dog, Cat>());
+
+BOOST_AUTO_TEST_CASE(static_dispatch) {
+    Animal animal;
+    Dog dog;
+    Bulldog bulldog;
+    Cat cat;
+
+    BOOST_TEST(poke::fn(animal) == "animal");
+    BOOST_TEST(poke::fn(cat) == "animal");
+    BOOST_TEST(poke::fn(dog) == "bark, then animal");
+    BOOST_TEST(poke::fn(bulldog) == "bark, then animal");
+
+    BOOST_TEST(meet::fn(dog, "the park", cat) == "chase in the park");
+    BOOST_TEST(meet::fn(bulldog, "the park", cat) == "chase in the park");
+    BOOST_TEST(meet::fn(cat, "the park", bulldog) == "run");
+    BOOST_TEST(meet::fn(cat, "the park", cat) == "ignore");
+    BOOST_TEST(meet::fn(animal, "the park", dog) == "ignore");
+
+    BOOST_TEST(pet::fn(&dog) == "wag");
+    BOOST_TEST(pet::fn(&bulldog) == "wag");
+    BOOST_TEST(fight::fn(dog, cat) == "dog wins");
+}
+
+BOOST_AUTO_TEST_CASE(static_dispatch_errors) {
+    Dog dog;
+    Cat cat;
+
+    BOOST_CHECK_THROW(fight::fn(dog, dog), ambiguous_error);
+    BOOST_CHECK_THROW(fight::fn(cat, cat), not_implemented_error);
+
+    struct Unknown : Animal {} unknown;
+    BOOST_CHECK_THROW(poke::fn(unknown), unknown_class_error);
+}
+
+namespace macros {
+
+BOOST_OPENMETHOD(poke, (virtual_<const Animal&>), std::string, animals);
+
+BOOST_OPENMETHOD_OVERRIDE(poke, (const Animal&), std::string) {
+    return "animal";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(poke, (const Dog& dog), std::string) {
+    return "bark, then " + next(dog);
+}
+
+BOOST_OPENMETHOD_OVERRIDE(poke, (const Cat&), std::string) {
+    return "hiss";
+}
+
+BOOST_OPENMETHOD_CLASSES(Dog, Bulldog, animals);
+
+using poke_method =
+    decltype(BOOST_OPENMETHOD_GUIDE(poke)(std::declval<const Animal&>()));
+
+static_assert(poke_method::resolve<Bulldog>() == poke_method::resolve<Dog>());
+static_assert(
+    poke_method::next<BOOST_OPENMETHOD_OVERRIDER(
+        poke, (const Dog&), std::string)::fn> ==
+    poke_method::resolve<Animal>());
+
+BOOST_AUTO_TEST_CASE(static_dispatch_macros) {
+    Animal animal;
+    Dog dog;
+    Bulldog bulldog;
+    Cat cat;
+
+    BOOST_TEST(poke(animal) == "animal");
+    BOOST_TEST(poke(dog) == "bark, then animal");
+    BOOST_TEST(poke(bulldog) == "bark, then animal");
+    BOOST_TEST(poke(cat) == "hiss");
+
+    BOOST_TEST((poke_method::has_next<BOOST_OPENMETHOD_OVERRIDER(
+                    poke, (const Dog&), std::string)::fn>()));
+    BOOST_TEST(!(poke_method::has_next<BOOST_OPENMETHOD_OVERRIDER(
+                     poke, (const Animal&), std::string)::fn>()));
+}
+
+} // namespace macros
+
+namespace carried_index {
+
+// The objects carry the indexes of their classes in the registry. Thus the
+// classes do not need to be polymorphic.
+
+struct Shape;
+struct Circle;
+struct Square;
+
+using shapes =
+    static_registry<Shape, use_classes<Circle, Square>, test_registry>;
+
+struct Shape : inplace_vindex<Shape, shapes> {};
+struct Circle : Shape, inplace_vindex<Circle, Shape> {};
+struct Square : Shape, inplace_vindex<Square, Shape> {};
+
+static_assert(shapes::static_vindex<Shape> == 0);
+static_assert(shapes::static_vindex<Circle> == 1);
+static_assert(shapes::static_vindex<Square> == 2);
+
+auto name_shape(const Shape&) -> std::string {
+    return "shape";
+}
+
+auto name_circle(const Circle&) -> std::string {
+    return "circle";
+}
+
+using name = shapes::method<
+    auto(virtual_<const Shape&>)->std::string, name_shape, name_circle>;
+
+auto meet_shapes(const Shape&, const Shape&) -> std::string {
+    return "shapes";
+}
+
+auto meet_circle_square(const Circle&, const Square&) -> std::string {
+    return "circle, square";
+}
+
+auto meet_square_shape(const Square&, const Shape&) -> std::string {
+    return "square, shape";
+}
+
+using meet = shapes::method<
+    auto(virtual_<const Shape&>, virtual_<const Shape&>)->std::string,
+    meet_shapes, meet_circle_square, meet_square_shape>;
+
+BOOST_AUTO_TEST_CASE(static_dispatch_carried_index) {
+    Shape shape;
+    Circle circle;
+    Square square;
+
+    BOOST_TEST(name::fn(shape) == "shape");
+    BOOST_TEST(name::fn(circle) == "circle");
+    BOOST_TEST(name::fn(square) == "shape");
+
+    BOOST_TEST(meet::fn(circle, square) == "circle, square");
+    BOOST_TEST(meet::fn(circle, circle) == "shapes");
+    BOOST_TEST(meet::fn(square, circle) == "square, shape");
+    BOOST_TEST(meet::fn(shape, square) == "shapes");
+}
+
+} // namespace carried_index
+
+namespace aliased_type_ids {
+
+// Each class has two type ids, which `type_index` maps to the same value, as
+// when a `type_info` is duplicated across shared libraries.
+struct aliasing_rtti {
+    alignas(2) inline static char ids[6];
+
+    template<class Class>
+    static auto static_type() -> type_id {
+        return &ids
+            [2 * boost::mp11::mp_find<
+                     boost::mp11::mp_list<Animal, Dog, Cat>, Class>::value];
+    }
+
+    static auto type_index(type_id type) -> type_id {
+        return reinterpret_cast<type_id>(
+            reinterpret_cast<std::uintptr_t>(type) & ~std::uintptr_t(1));
+    }
+};
+
+BOOST_AUTO_TEST_CASE(static_class_hash_uses_type_index) {
+    detail::static_class_hash<
+        aliasing_rtti, boost::mp11::mp_list<Animal, Dog, Cat>>
+        table;
+
+    for (std::size_t index = 0; index < 3; ++index) {
+        BOOST_TEST(table.find(&aliasing_rtti::ids[2 * index]) == index);
+        BOOST_TEST(table.find(&aliasing_rtti::ids[2 * index + 1]) == index);
+    }
+
+    static char unknown;
+    BOOST_TEST(table.find(&unknown) == 3u);
+}
+
+} // namespace aliased_type_ids
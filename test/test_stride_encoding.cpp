@@ -0,0 +1,131 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE stride_encoding
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+
+// 3 x 3 x 2 cells
+
+auto trio_animals(const Animal&, const Animal&, const Animal&)
+    -> std::string {
+    return "noise";
+}
+
+auto trio_dog_cat(const Dog&, const Cat&, const Animal&) -> std::string {
+    return "chase";
+}
+
+auto trio_cat_dog(const Cat&, const Dog&, const Dog&) -> std::string {
+    return "run";
+}
+
+namespace premultiplied {
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::premultiplied_strides> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(trio);
+using trio = method<
+    BOOST_OPENMETHOD_ID(trio),
+    auto(
+        virtual_<const Animal&>, virtual_<const Animal&>,
+        virtual_<const Animal&>)
+        ->std::string,
+    test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(
+    trio::override<trio_animals, trio_dog_cat, trio_cat_dog>);
+
+BOOST_AUTO_TEST_CASE(premultiplied_strides) {
+    auto comp = test_registry::initialize();
+    BOOST_TEST(comp.report.cells == 18u);
+    BOOST_TEST(comp.report.padding == 0u);
+
+    auto& fn = trio::fn;
+    BOOST_TEST(comp[fn]->strides[1] == 9u);
+
+    // The entries for the third parameter are multiples of its stride.
+    auto animal_entry =
+        test_registry::static_vptr<Animal>[fn.slots_strides_ptr[2]].i;
+    auto dog_entry =
+        test_registry::static_vptr<Dog>[fn.slots_strides_ptr[2]].i;
+    BOOST_TEST(animal_entry + dog_entry == 9u);
+
+    Animal animal;
+    Dog dog;
+    Cat cat;
+
+    BOOST_TEST(trio::fn(dog, cat, cat) == "chase");
+    BOOST_TEST(trio::fn(dog, cat, dog) == "chase");
+    BOOST_TEST(trio::fn(cat, dog, dog) == "run");
+    BOOST_TEST(trio::fn(cat, dog, cat) == "noise");
+    BOOST_TEST(trio::fn(animal, animal, dog) == "noise");
+    BOOST_TEST(trio::fn(dog, dog, dog) == "noise");
+}
+
+} // namespace premultiplied
+
+namespace power_of_two {
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::power_of_two_strides> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+struct BOOST_OPENMETHOD_ID(trio);
+using trio = method<
+    BOOST_OPENMETHOD_ID(trio),
+    auto(
+        virtual_<const Animal&>, virtual_<const Animal&>,
+        virtual_<const Animal&>)
+        ->std::string,
+    test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(
+    trio::override<trio_animals, trio_dog_cat, trio_cat_dog>);
+
+BOOST_AUTO_TEST_CASE(power_of_two_strides) {
+    auto comp = test_registry::initialize();
+
+    // 4 x 4 x 2 cells
+    BOOST_TEST(comp.report.cells == 18u);
+    BOOST_TEST(comp.report.padding == 14u);
+
+    auto& fn = trio::fn;
+    BOOST_TEST(fn.slots_strides_ptr[3] == 2u);
+    BOOST_TEST(fn.slots_strides_ptr[4] == 4u);
+
+    Animal animal;
+    Dog dog;
+    Cat cat;
+
+    BOOST_TEST(trio::fn(dog, cat, cat) == "chase");
+    BOOST_TEST(trio::fn(dog, cat, dog) == "chase");
+    BOOST_TEST(trio::fn(cat, dog, dog) == "run");
+    BOOST_TEST(trio::fn(cat, dog, cat) == "noise");
+    BOOST_TEST(trio::fn(animal, animal, dog) == "noise");
+    BOOST_TEST(trio::fn(dog, dog, dog) == "noise");
+}
+
+} // namespace power_of_two
@@ -0,0 +1,129 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/throw_error_handler.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE symmetric_method
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Thing {
+    virtual ~Thing() {
+    }
+
+    virtual auto name() const -> std::string {
+        return "thing";
+    }
+};
+
+struct Ship : Thing {
+    auto name() const -> std::string override {
+        return "ship";
+    }
+};
+
+struct Asteroid : Thing {
+    auto name() const -> std::string override {
+        return "asteroid";
+    }
+};
+
+struct Planet : Thing {
+    auto name() const -> std::string override {
+        return "planet";
+    }
+};
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::throw_error_handler> {};
+
+BOOST_OPENMETHOD_CLASSES(Thing, Ship, Asteroid, Planet, test_registry);
+
+BOOST_OPENMETHOD(
+    collide,
+    (virtual_<const Thing&>, const std::string&, virtual_<const Thing&>),
+    std::string, test_registry);
+
+using collide_method = method<
+    BOOST_OPENMETHOD_ID(collide),
+    auto(virtual_<const Thing&>, const std::string&, virtual_<const Thing&>)
+        ->std::string,
+    test_registry>;
+
+template<>
+struct boost::openmethod::symmetric_method<collide_method> : std::true_type {
+};
+
+BOOST_OPENMETHOD_OVERRIDE(
+    collide, (const Thing& a, const std::string& how, const Thing& b),
+    std::string) {
+    return a.name() + " " + how + " " + b.name();
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    collide, (const Ship& a, const std::string& how, const Asteroid& b),
+    std::string) {
+    return "boom, " + next(a, how, b);
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    collide, (const Ship& a, const std::string&, const Ship& b), std::string) {
+    return a.name() + " docks " + b.name();
+}
+
+// Ambiguous, because each overrider also covers the other order.
+
+BOOST_OPENMETHOD_OVERRIDE(
+    collide, (const Ship& a, const std::string&, const Planet& b),
+    std::string) {
+    return a.name() + " lands on " + b.name();
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    collide, (const Planet& a, const std::string&, const Ship& b),
+    std::string) {
+    return a.name() + " attracts " + b.name();
+}
+
+// Applies in both orders to (Asteroid, Asteroid), and is more specific
+// than (Thing, Thing) for (Ship, Asteroid).
+
+BOOST_OPENMETHOD_OVERRIDE(
+    collide, (const Asteroid& a, const std::string&, const Thing& b),
+    std::string) {
+    return a.name() + " grazes " + b.name();
+}
+
+BOOST_AUTO_TEST_CASE(symmetric_dispatch) {
+    auto report = test_registry::initialize().report;
+
+    // 4 groups, 4 * 5 / 2 cells
+    BOOST_TEST(report.cells == 10u);
+
+    Thing thing;
+    Ship ship;
+    Asteroid asteroid;
+    Planet planet;
+
+    BOOST_TEST(collide(thing, "hits", planet) == "thing hits planet");
+    BOOST_TEST(
+        collide(ship, "hits", asteroid) == "boom, asteroid grazes ship");
+    BOOST_TEST(
+        collide(asteroid, "hits", ship) == "boom, asteroid grazes ship");
+    BOOST_TEST(collide(ship, "hits", ship) == "ship docks ship");
+    BOOST_CHECK_THROW(collide(ship, "hits", planet), ambiguous_error);
+    BOOST_CHECK_THROW(collide(planet, "hits", ship), ambiguous_error);
+    BOOST_TEST(collide(asteroid, "hits", planet) == "asteroid grazes planet");
+    BOOST_TEST(collide(planet, "hits", asteroid) == "asteroid grazes planet");
+    BOOST_TEST(
+        collide(asteroid, "hits", asteroid) == "asteroid grazes asteroid");
+}
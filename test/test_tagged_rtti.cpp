@@ -0,0 +1,182 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/tagged_rtti.hpp>
+#include <boost/openmethod/policies/throw_error_handler.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE tagged_rtti
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal : tagged<Animal> {
+    Animal() = default;
+
+    Animal(std::string name) : name(std::move(name)) {
+    }
+
+    virtual ~Animal() = default;
+
+    std::string name;
+};
+
+struct Dog : tagged<Dog, Animal> {
+    Dog() = default;
+
+    Dog(std::string name) : tagged(std::move(name)) {
+    }
+};
+
+struct Cat : tagged<Cat, Animal> {};
+
+using registry_type = test_registry_<
+    __COUNTER__, policies::tagged_rtti>::without<policies::type_hash>;
+
+struct test_registry : registry_type {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, test_registry);
+
+BOOST_OPENMETHOD(
+    poke, (virtual_<const Animal&>), std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(poke, (const Animal&), std::string) {
+    return "animal";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(poke, (const Dog& dog), std::string) {
+    return dog.name + " barks";
+}
+
+BOOST_OPENMETHOD(
+    meet, (virtual_<const Animal&>, virtual_<const Animal&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Animal&, const Animal&), std::string) {
+    return "ignore";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(meet, (const Dog&, const Cat&), std::string) {
+    return "chase";
+}
+
+struct Shape : tagged<Shape> {
+    virtual ~Shape() = default;
+};
+
+struct Circle : tagged<Circle, Shape> {};
+
+struct shape_registry
+    : test_registry_<__COUNTER__, policies::tagged_rtti>::without<
+          policies::type_hash> {};
+
+BOOST_OPENMETHOD_CLASSES(Shape, Circle, shape_registry);
+
+struct Robot : tagged<Robot> {
+    virtual ~Robot() = default;
+};
+
+struct Android : tagged<Android, Robot> {};
+
+struct checked_registry
+    : test_registry_<
+          __COUNTER__, policies::tagged_rtti, policies::runtime_checks,
+          policies::throw_error_handler>::without<policies::type_hash> {};
+
+// Android is not registered.
+BOOST_OPENMETHOD_CLASSES(Robot, checked_registry);
+
+BOOST_OPENMETHOD(beep, (virtual_<const Robot&>), std::string, checked_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(beep, (const Robot&), std::string) {
+    return "beep";
+}
+
+using rtti = test_registry::rtti;
+
+static_assert(rtti::is_polymorphic<Dog>);
+static_assert(!rtti::is_polymorphic<std::string>);
+
+// The forwarding constructor is explicit, and does not hijack copies.
+static_assert(!std::is_convertible_v<std::string, tagged<Dog, Animal>>);
+static_assert(std::is_constructible_v<tagged<Dog, Animal>, std::string>);
+static_assert(std::is_copy_constructible_v<Dog>);
+
+BOOST_AUTO_TEST_CASE(dense_tags) {
+    test_registry::initialize();
+
+    // The tags are allocated consecutively, starting from zero.
+    auto animal = std::uintptr_t(rtti::static_type<Animal>());
+    auto dog = std::uintptr_t(rtti::static_type<Dog>());
+    auto cat = std::uintptr_t(rtti::static_type<Cat>());
+    BOOST_TEST(animal < 3u);
+    BOOST_TEST(dog < 3u);
+    BOOST_TEST(cat < 3u);
+    BOOST_TEST(animal != dog);
+    BOOST_TEST(dog != cat);
+    BOOST_TEST(cat != animal);
+
+    // Thus the vptr vector contains one entry per class.
+    BOOST_TEST(detail::vptr_vector_vptrs<registry_type>.size() == 3u);
+
+    // Each registry allocates its own tags.
+    shape_registry::initialize();
+    auto shape = std::uintptr_t(shape_registry::rtti::static_type<Shape>());
+    auto circle = std::uintptr_t(shape_registry::rtti::static_type<Circle>());
+    BOOST_TEST(shape < 2u);
+    BOOST_TEST(circle < 2u);
+    BOOST_TEST(shape != circle);
+
+    // Tags do not change when the registry is initialized again.
+    test_registry::initialize();
+    BOOST_TEST(std::uintptr_t(rtti::static_type<Dog>()) == dog);
+}
+
+BOOST_AUTO_TEST_CASE(tagged_dispatch) {
+    test_registry::initialize();
+
+    Animal animal;
+    Dog snoopy("Snoopy");
+    Cat cat;
+
+    BOOST_TEST(rtti::dynamic_type<Animal>(snoopy) == rtti::static_type<Dog>());
+    BOOST_TEST(poke(animal) == "animal");
+    BOOST_TEST(poke(snoopy) == "Snoopy barks");
+    BOOST_TEST(poke(cat) == "animal");
+    BOOST_TEST(meet(snoopy, cat) == "chase");
+    BOOST_TEST(meet(cat, snoopy) == "ignore");
+
+    // Copies get the tag of their own class.
+    Dog copy = snoopy;
+    Animal sliced = snoopy;
+    BOOST_TEST(poke(copy) == "Snoopy barks");
+    BOOST_TEST(poke(sliced) == "animal");
+
+    animal = snoopy;
+    BOOST_TEST(poke(animal) == "animal");
+}
+
+BOOST_AUTO_TEST_CASE(tags_assigned_at_registration) {
+    // The tags are assigned before the first call to `initialize`, thus
+    // objects created before it have a valid tag.
+    BOOST_TEST(detail::tagged_rtti_tag<Robot> != detail::tagged_rtti_no_tag);
+
+    Robot robot;
+    checked_registry::initialize();
+    BOOST_TEST(beep(robot) == "beep");
+}
+
+BOOST_AUTO_TEST_CASE(unregistered_tagged_class) {
+    checked_registry::initialize();
+
+    Android android;
+    BOOST_TEST(detail::tagged_rtti_tag<Android> == detail::tagged_rtti_no_tag);
+    BOOST_CHECK_THROW(beep(android), unknown_class_error);
+}
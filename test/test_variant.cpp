@@ -0,0 +1,132 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <variant>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/throw_error_handler.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE variant
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+// The alternatives need not be polymorphic.
+struct Circle {
+    double radius;
+};
+
+struct Square {
+    double side;
+};
+
+struct Point {};
+
+using Shape = std::variant<Circle, Square, Point>;
+
+struct test_registry
+    : test_registry_<__COUNTER__, policies::throw_error_handler> {};
+
+BOOST_OPENMETHOD_CLASSES(Shape, Circle, Square, Point, test_registry);
+
+BOOST_OPENMETHOD(name, (virtual_<const Shape&>), std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Shape&), std::string) {
+    return "shape";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Circle& circle), std::string) {
+    return "circle of radius " + std::to_string(int(circle.radius));
+}
+
+BOOST_OPENMETHOD_OVERRIDE(name, (const Square&), std::string) {
+    return "square";
+}
+
+BOOST_OPENMETHOD(
+    intersect, (virtual_<const Shape&>, virtual_<const Shape&>), std::string,
+    test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(
+    intersect, (const Circle&, const Square&), std::string) {
+    return "circle-square";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    intersect, (const Square&, const Circle&), std::string) {
+    return "square-circle";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(
+    intersect, (const Circle&, const Circle&), std::string) {
+    return "circle-circle";
+}
+
+// The alternatives do not convert to a reference to a non-const variant, thus
+// BOOST_OPENMETHOD_OVERRIDE cannot locate the method.
+struct BOOST_OPENMETHOD_ID(scale);
+using scale = method<
+    BOOST_OPENMETHOD_ID(scale), auto(virtual_<Shape&>, double)->void,
+    test_registry>;
+
+auto scale_circle(Circle& circle, double factor) -> void {
+    circle.radius *= factor;
+}
+
+auto scale_square(Square& square, double factor) -> void {
+    square.side *= factor;
+}
+
+BOOST_OPENMETHOD_REGISTER(scale::override<scale_circle, scale_square>);
+
+BOOST_AUTO_TEST_CASE(variant_dispatch) {
+    test_registry::initialize();
+
+    Shape circle = Circle{2};
+    Shape square = Square{3};
+    Shape point = Point{};
+
+    BOOST_TEST(name(circle) == "circle of radius 2");
+    BOOST_TEST(name(square) == "square");
+    BOOST_TEST(name(point) == "shape");
+
+    BOOST_TEST(intersect(circle, square) == "circle-square");
+    BOOST_TEST(intersect(square, circle) == "square-circle");
+    BOOST_TEST(intersect(circle, circle) == "circle-circle");
+
+    scale::fn(circle, 2);
+    scale::fn(square, 2);
+    BOOST_TEST(std::get<Circle>(circle).radius == 4);
+    BOOST_TEST(std::get<Square>(square).side == 6);
+
+    // The vptr is found via the index of the variant.
+    BOOST_TEST(
+        (detail::acquire_vptr<test_registry>(circle) ==
+         test_registry::static_vptr<Circle>));
+
+    square = Circle{1};
+    BOOST_TEST(name(square) == "circle of radius 1");
+}
+
+BOOST_AUTO_TEST_CASE(variant_errors) {
+    test_registry::initialize();
+
+    Shape square = Square{1};
+    Shape point = Point{};
+
+    try {
+        intersect(square, point);
+        BOOST_FAIL("should have thrown");
+    } catch (const not_implemented_error& error) {
+        // The error reports the types of the alternatives.
+        using rtti = test_registry::rtti;
+        BOOST_TEST(error.types[0] == rtti::static_type<Square>());
+        BOOST_TEST(error.types[1] == rtti::static_type<Point>());
+    }
+}
@@ -11,6 +11,8 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #define BOOST_TEST_MODULE openmethod
 #include <boost/test/unit_test.hpp>
@@ -201,8 +203,12 @@ struct indirect_test_registry
     : test_registry_<N>::template with<policies::indirect_vptr> {};
 
 template<int N>
-using policy_types =
-    boost::mp11::mp_list<test_registry_<N>, indirect_test_registry<N>>;
+struct cached_test_registry
+    : test_registry_<N>::template with<policies::cached_vptr> {};
+
+template<int N>
+using policy_types = boost::mp11::mp_list<
+    test_registry_<N>, indirect_test_registry<N>, cached_test_registry<N>>;
 
 struct BOOST_OPENMETHOD_ID(poke);
 struct BOOST_OPENMETHOD_ID(fight);
@@ -341,3 +347,62 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(
 }
 
 } // namespace test_shared_virtual_ptr_dispatch
+
+namespace test_cached_vptr_refresh {
+
+BOOST_AUTO_TEST_CASE(cached_vptr_refresh) {
+    using Registry = cached_test_registry<__COUNTER__>;
+
+    BOOST_OPENMETHOD_REGISTER(use_classes<Player, Bear, Registry>);
+
+    Registry::initialize();
+
+    auto box = detail::box_vptr<Registry>(Registry::static_vptr<Bear>);
+    BOOST_TEST(detail::unbox_vptr(box) == Registry::static_vptr<Bear>);
+
+    // After a re-initialization, the cache is refreshed on first use.
+    Registry::initialize();
+    BOOST_TEST(box.epoch != Registry::epoch);
+    BOOST_TEST(detail::unbox_vptr(box) == Registry::static_vptr<Bear>);
+    BOOST_TEST(box.epoch == Registry::epoch);
+    BOOST_TEST(box.vp == Registry::static_vptr<Bear>);
+}
+
+BOOST_AUTO_TEST_CASE(cached_vptr_concurrent_refresh) {
+    using Registry = cached_test_registry<__COUNTER__>;
+
+    BOOST_OPENMETHOD_REGISTER(use_classes<Player, Bear, Registry>);
+
+    Registry::initialize();
+
+    auto box = detail::box_vptr<Registry>(Registry::static_vptr<Bear>);
+
+    // The `const` member functions of a `virtual_ptr` may be called from
+    // several threads, which refresh the cache concurrently.
+    for (int i = 0; i < 20; ++i) {
+        Registry::initialize();
+
+        std::vector<std::thread> threads;
+        std::atomic<int> errors{0};
+
+        for (int j = 0; j < 4; ++j) {
+            threads.emplace_back([&] {
+                for (int k = 0; k < 100; ++k) {
+                    if (detail::unbox_vptr(box) !=
+                        Registry::static_vptr<Bear>) {
+                        ++errors;
+                    }
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        BOOST_TEST(errors.load() == 0);
+        BOOST_TEST(box.epoch == Registry::epoch);
+    }
+}
+
+} // namespace test_cached_vptr_refresh
@@ -54,8 +54,13 @@ struct direct_map
 
 struct indirect_map : direct_map::with<indirect_vptr> {};
 
+struct cached_vector : test_registry_<__COUNTER__>::with<cached_vptr> {};
+
+struct cached_map : direct_map::with<cached_vptr> {};
+
 using test_policies = boost::mp11::mp_list<
-    direct_vector, indirect_vector, direct_map, indirect_map>;
+    direct_vector, indirect_vector, direct_map, indirect_map, cached_vector,
+    cached_map>;
 
 using test_classes = boost::mp11::mp_list<Dog, Cat>;
 
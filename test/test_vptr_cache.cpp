@@ -0,0 +1,122 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <thread>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/vptr_map.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE vptr_cache
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+struct Animal {
+    virtual ~Animal() {
+    }
+};
+
+struct Dog : Animal {};
+struct Cat : Animal {};
+struct Bird : Animal {};
+
+auto poke_animal(const Animal&) -> std::string {
+    return "animal";
+}
+
+auto poke_dog(const Dog&) -> std::string {
+    return "bark";
+}
+
+auto poke_cat(const Cat&) -> std::string {
+    return "hiss";
+}
+
+template<class Registry, class Poke>
+void check_cache() {
+    using registry_type = typename Registry::registry_type;
+    constexpr auto size =
+        registry_type::template policy<policies::vptr_cache>::size;
+    auto& cache = detail::vptr_cache_instance<registry_type, size>;
+    auto bird_type = Registry::rtti::template static_type<Bird>();
+
+    Registry::initialize();
+
+    Dog dog;
+    Cat cat;
+    Bird bird;
+
+    for (int i = 0; i < 2; ++i) {
+        BOOST_TEST(Poke::fn(dog) == "bark");
+        BOOST_TEST(Poke::fn(cat) == "hiss");
+        BOOST_TEST(Poke::fn(bird) == "animal");
+    }
+
+    // The last type is in the cache.
+    auto vptr = cache.find(Registry::epoch, bird_type);
+    BOOST_REQUIRE(vptr != nullptr);
+    BOOST_TEST(*vptr == Registry::template static_vptr<Bird>);
+
+    // Other threads have their own cache.
+    std::thread([&] {
+        auto& thread_cache = detail::vptr_cache_instance<registry_type, size>;
+        BOOST_TEST(&thread_cache != &cache);
+        BOOST_TEST(thread_cache.find(Registry::epoch, bird_type) == nullptr);
+        BOOST_TEST(Poke::fn(dog) == "bark");
+    }).join();
+
+    // A new initialization invalidates the cache.
+    Registry::initialize();
+    BOOST_TEST(cache.find(Registry::epoch, bird_type) == nullptr);
+    BOOST_TEST(Poke::fn(dog) == "bark");
+    BOOST_TEST(Poke::fn(cat) == "hiss");
+}
+
+namespace with_vector {
+
+struct test_registry
+    : test_registry_<
+          __COUNTER__, policies::vptr_cache_options<3>,
+          policies::runtime_checks> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, Bird, test_registry);
+
+struct BOOST_OPENMETHOD_ID(poke);
+using poke = method<
+    BOOST_OPENMETHOD_ID(poke), auto(virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(poke::override<poke_animal, poke_dog, poke_cat>);
+
+BOOST_AUTO_TEST_CASE(vptr_vector_cache) {
+    check_cache<test_registry, poke>();
+}
+
+} // namespace with_vector
+
+namespace with_map {
+
+struct test_registry
+    : test_registry_<
+          __COUNTER__, policies::vptr_map<>, policies::vptr_cache> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, Bird, test_registry);
+
+struct BOOST_OPENMETHOD_ID(poke);
+using poke = method<
+    BOOST_OPENMETHOD_ID(poke), auto(virtual_<const Animal&>)->std::string,
+    test_registry>;
+
+BOOST_OPENMETHOD_REGISTER(poke::override<poke_animal, poke_dog, poke_cat>);
+
+BOOST_AUTO_TEST_CASE(vptr_map_cache) {
+    check_cache<test_registry, poke>();
+}
+
+} // namespace with_map
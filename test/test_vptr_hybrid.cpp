@@ -0,0 +1,124 @@
+// Copyright (c) 2018-2025 Jean-Louis Leroy
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+
+#include <boost/openmethod.hpp>
+#include <boost/openmethod/policies/vptr_hybrid.hpp>
+#include <boost/openmethod/policies/throw_error_handler.hpp>
+#include <boost/openmethod/initialize.hpp>
+
+#include "test_util.hpp"
+
+#define BOOST_TEST_MODULE vptr_hybrid
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::openmethod;
+
+// Simulate type ids coming from the main program, and from a plugin loaded
+// far away in memory.
+static char type_ids[4 << 20];
+
+struct Animal {
+    static constexpr std::size_t id = 0;
+
+    virtual ~Animal() {
+    }
+
+    virtual auto type() const -> std::size_t {
+        return id;
+    }
+};
+
+template<class Class, class Base, std::size_t Id>
+struct with_id : Base {
+    static constexpr std::size_t id = Id;
+
+    auto type() const -> std::size_t override {
+        return id;
+    }
+};
+
+struct Dog : with_id<Dog, Animal, 8> {};
+struct Cat : with_id<Cat, Animal, 16> {};
+struct Wolf : with_id<Wolf, Dog, (3 << 20)> {};
+struct Lion : with_id<Lion, Cat, (3 << 20) + 8> {};
+struct Unicorn : with_id<Unicorn, Animal, (2 << 20)> {};
+
+struct custom_rtti : policies::rtti {
+    template<class Registry>
+    struct fn : defaults {
+        template<class T>
+        static constexpr bool is_polymorphic = std::is_base_of_v<Animal, T>;
+
+        template<typename T>
+        static auto static_type() -> type_id {
+            if constexpr (is_polymorphic<T>) {
+                return &type_ids[T::id];
+            } else {
+                static char id;
+
+                return &id;
+            }
+        }
+
+        template<typename T>
+        static auto dynamic_type(const T& obj) -> type_id {
+            if constexpr (is_polymorphic<T>) {
+                return &type_ids[obj.type()];
+            } else {
+                return static_type<T>();
+            }
+        }
+    };
+};
+
+struct test_registry : test_registry_<
+                           __COUNTER__, custom_rtti, policies::vptr_hybrid<>,
+                           policies::runtime_checks,
+                           policies::throw_error_handler> {};
+
+BOOST_OPENMETHOD_CLASSES(Animal, Dog, Cat, Wolf, Lion, test_registry);
+
+BOOST_OPENMETHOD(poke, (virtual_<const Animal&>), std::string, test_registry);
+
+BOOST_OPENMETHOD_OVERRIDE(poke, (const Animal&), std::string) {
+    return "animal";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(poke, (const Dog&), std::string) {
+    return "bark";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(poke, (const Wolf&), std::string) {
+    return "howl";
+}
+
+BOOST_OPENMETHOD_OVERRIDE(poke, (const Lion&), std::string) {
+    return "roar";
+}
+
+BOOST_AUTO_TEST_CASE(hybrid_dispatch) {
+    test_registry::initialize();
+
+    Animal animal;
+    Dog dog;
+    Cat cat;
+    Wolf wolf;
+    Lion lion;
+
+    // Via the vector.
+    BOOST_TEST(poke(animal) == "animal");
+    BOOST_TEST(poke(dog) == "bark");
+    BOOST_TEST(poke(cat) == "animal");
+
+    // Via the map.
+    BOOST_TEST(poke(wolf) == "howl");
+    BOOST_TEST(poke(lion) == "roar");
+
+    // Not registered, outside of the main cluster.
+    Unicorn unicorn;
+    BOOST_CHECK_THROW(poke(unicorn), unknown_class_error);
+}